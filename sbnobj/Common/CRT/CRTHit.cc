@@ -1,4 +1,164 @@
 #include "sbnobj/Common/CRT/CRTHit.hh"
 #include "sbnobj/Common/CRT/CRTHit_Legacy.hh"
 
-//nothing to do here
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+  /// Names of the known CRT walls, by `tagger_id`. New names are only appended:
+  /// the position of a name is its identifier, stored in the data files.
+  /// ICARUS names are the CRT regions of its hit reconstruction, SBND names the
+  /// tagger volumes of its geometry description.
+  std::vector<std::string> const& taggerNames() {
+    static std::vector<std::string> const names {
+      "",        // sbn::crt::CRTHit::NoTagger
+      "unknown", // sbn::crt::CRTHit::UnknownTagger
+      // ICARUS
+      "Top", "RimWest", "RimEast", "RimSouth", "RimNorth",
+      "WestSouth", "WestCenter", "WestNorth", "EastSouth", "EastCenter", "EastNorth",
+      "South", "North", "Bottom",
+      // SBND
+      "volTaggerSideRight_0", "volTaggerSideLeft_0", "volTaggerFaceFront_0",
+      "volTaggerFaceBack_0", "volTaggerBot_0", "volTaggerTopLow_0", "volTaggerTopHigh_0",
+      "volTaggerNorth_0", "volTaggerSouth_0", "volTaggerWest_0", "volTaggerEast_0",
+      "volTaggerBottom_0",
+    };
+    return names;
+  }
+
+} // local namespace
+
+
+namespace sbn::crt {
+
+  CRTHit::PEsMap_t CRTHit::pesmapCopy() const {
+    PEsMap_t pesMap;
+    for (auto const& [ feb, pes ]: pesmap())
+      pesMap.emplace_hint(pesMap.end(), feb, pes.toVector());
+    return pesMap;
+  }
+
+
+  void CRTHit::addPE(uint8_t feb, int channel, float pe) {
+    // fast path: the signal belongs to the last FEB, or to a new last one
+    if (pes_feb.empty() || (feb > pes_feb.back())) {
+      if (pes_offset.empty()) pes_offset.push_back(0);
+      pes_feb.push_back(feb);
+      pes_offset.push_back(pes_offset.back());
+    }
+    else if (feb != pes_feb.back()) {
+      // FEB out of order: the signal is inserted at the end of its group
+      auto const itFEB = std::lower_bound(pes_feb.begin(), pes_feb.end(), feb);
+      std::size_t const iFEB = std::distance(pes_feb.begin(), itFEB);
+      if (*itFEB != feb) {
+        pes_feb.insert(itFEB, feb);
+        pes_offset.insert(pes_offset.begin() + iFEB + 1, pes_offset[iFEB]);
+      }
+      uint32_t const pos = pes_offset[iFEB + 1];
+      pes_channel.insert(pes_channel.begin() + pos, channel);
+      pes_pe.insert(pes_pe.begin() + pos, pe);
+      for (std::size_t i = iFEB + 1; i < pes_offset.size(); ++i) ++pes_offset[i];
+      return;
+    }
+    pes_channel.push_back(channel);
+    pes_pe.push_back(pe);
+    ++pes_offset.back();
+  }
+
+
+  void CRTHit::setPEs(PEsMap_t const& pesMap) {
+    std::size_t nPEs = 0;
+    for (auto const& [ feb, pes ]: pesMap) nPEs += pes.size();
+
+    clearPEs();
+    reservePEs(pesMap.size(), nPEs);
+    if (pesMap.empty()) return;
+
+    pes_offset.push_back(0);
+    for (auto const& [ feb, pes ]: pesMap) {
+      pes_feb.push_back(feb);
+      for (auto const& [ channel, pe ]: pes) {
+        pes_channel.push_back(channel);
+        pes_pe.push_back(pe);
+      }
+      pes_offset.push_back(pes_channel.size());
+    }
+  }
+
+
+  void CRTHit::clearPEs() {
+    pes_feb.clear();
+    pes_offset.clear();
+    pes_channel.clear();
+    pes_pe.clear();
+  }
+
+
+  void CRTHit::reservePEs(std::size_t nFEBs, std::size_t nPEs) {
+    pes_feb.reserve(nFEBs);
+    pes_offset.reserve(nFEBs + 1);
+    pes_channel.reserve(nPEs);
+    pes_pe.reserve(nPEs);
+  }
+
+
+  uint32_t CRTHit::taggerID(std::string const& name) {
+    static std::unordered_map<std::string, uint32_t> const taggerIDs = []()
+      {
+        std::vector<std::string> const& names = taggerNames();
+        std::unordered_map<std::string, uint32_t> ids;
+        for (uint32_t id = 0; id < names.size(); ++id) ids.emplace(names[id], id);
+        return ids;
+      }();
+    auto const it = taggerIDs.find(name);
+    if (it == taggerIDs.end()) {
+      throw std::invalid_argument("sbn::crt::CRTHit::taggerID(): tagger name '"
+        + name + "' is not in the list of known CRT walls");
+    }
+    return it->second;
+  }
+
+
+  std::string const& CRTHit::taggerName(uint32_t id) {
+    std::vector<std::string> const& names = taggerNames();
+    return names[(id < names.size())? id: UnknownTagger];
+  }
+
+
+  std::vector<CRTHit::ChannelPE_t> CRTHit::FEBPEs::toVector() const {
+    std::vector<ChannelPE_t> pes;
+    pes.reserve(fSize);
+    for (std::size_t i = 0; i < fSize; ++i) pes.emplace_back(fChannels[i], fPEs[i]);
+    return pes;
+  }
+
+
+  CRTHit::FEBPEs CRTHit::PEsMapView::at(uint8_t feb) const {
+    std::size_t const i = indexOf(feb);
+    if (i >= size()) {
+      throw std::out_of_range
+        ("sbn::crt::CRTHit::pesmap().at(): no signal from FEB " + std::to_string(feb));
+    }
+    return valueAt(i).second;
+  }
+
+
+  auto CRTHit::PEsMapView::valueAt(std::size_t i) const -> value_type {
+    uint32_t const begin = fHit->pes_offset[i], end = fHit->pes_offset[i + 1];
+    return { fHit->pes_feb[i],
+      FEBPEs{ fHit->pes_channel.data() + begin, fHit->pes_pe.data() + begin, end - begin } };
+  }
+
+
+  std::size_t CRTHit::PEsMapView::indexOf(uint8_t feb) const {
+    auto const& febs = fHit->pes_feb;
+    auto const it = std::lower_bound(febs.begin(), febs.end(), feb);
+    return ((it == febs.end()) || (*it != feb))? febs.size(): std::distance(febs.begin(), it);
+  }
+
+} // namespace sbn::crt
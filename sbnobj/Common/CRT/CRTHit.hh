@@ -13,6 +13,8 @@
 #define CRTHit_hh_
 
 #include <cstdint>
+#include <cstddef>
+#include <iterator>
 #include <vector>
 #include <map>
 #include <string>
@@ -22,8 +24,32 @@ namespace sbn::crt {
 
     struct CRTHit{
 
+      /// Type of the former `pesmap` data member (still used for conversions).
+      using PEsMap_t = std::map< uint8_t, std::vector<std::pair<int,float> > >;
+
+      /// Local channel and PE of a signal, as in the former `pesmap`.
+      using ChannelPE_t = std::pair<int,float>;
+
+      class FEBPEs;
+      class PEsMapView;
+
+      /// Value of `tagger_id` for no tagger name (empty name).
+      static constexpr uint32_t NoTagger = 0;
+
+      /// Value of `tagger_id` for the tagger explicitly named `"unknown"`.
+      static constexpr uint32_t UnknownTagger = 1;
+
       std::vector<uint8_t> feb_id; ///< FEB address
-      std::map< uint8_t, std::vector<std::pair<int,float> > > pesmap; ///< Saves signal hit information (FEB, local-channel and PE) .
+
+      // Signal hit information (FEB, local-channel and PE), in flat format:
+      // the signals of the FEB `pes_feb[i]` are the ones with index from
+      // `pes_offset[i]` to `pes_offset[i + 1]` in `pes_channel` and `pes_pe`.
+      // Use `pesmap()` to read it, and `addPE()` or `setPEs()` to fill it.
+      std::vector<uint8_t>   pes_feb; ///< FEB address of each group of signals (increasing).
+      std::vector<uint32_t>  pes_offset; ///< Index of the first signal of each FEB, plus the total (empty if no FEB).
+      std::vector<int>       pes_channel; ///< Local channel of each signal.
+      std::vector<float>     pes_pe; ///< Photo-electrons (PE) of each signal.
+
       float         peshit; ///< Total photo-electron (PE) in a crt hit.
 
       uint64_t       ts0_s; ///< Second-only part of timestamp T0.
@@ -42,7 +68,7 @@ namespace sbn::crt {
       float          z_pos; ///< position in z-direction (cm).
       float          z_err; ///< position uncertainty in z-direction (cm).
 
-      std::string   tagger; ///< Name of the CRT wall (in the form of strings).
+      uint32_t   tagger_id = NoTagger; ///< Identifier of the name of the CRT wall (see `taggerName()`).
 
       CRTHit() {}
 
@@ -51,8 +77,167 @@ namespace sbn::crt {
       // nano-second part is enough and we saved entire time there.
       int64_t ts1() const { return static_cast<int64_t>(ts1_ns); }
 
+      /// Returns the signal hit information in a form mimicking the former `pesmap` map.
+      PEsMapView pesmap() const;
+
+      /// Returns the signal hit information as a map (like the former `pesmap`).
+      PEsMap_t pesmapCopy() const;
+
+      /// Adds a signal; like the former `pesmap[feb].emplace_back(channel, pe)`.
+      void addPE(uint8_t feb, int channel, float pe);
+
+      /// Replaces all the signal hit information with the content of `pesMap`.
+      void setPEs(PEsMap_t const& pesMap);
+
+      /// Removes all the signal hit information.
+      void clearPEs();
+
+      /// Preallocates memory for `nFEBs` FEBs and `nPEs` signals.
+      void reservePEs(std::size_t nFEBs, std::size_t nPEs);
+
+      /// Returns the name of the CRT wall (see `taggerName(uint32_t)`).
+      std::string const& taggerName() const { return taggerName(tagger_id); }
+
+      /// Sets the CRT wall to the one named `name` (see `taggerID()`).
+      void setTagger(std::string const& name) { tagger_id = taggerID(name); }
+
+      /**
+       * Returns the identifier of the tagger named `name`.
+       *
+       * The identifiers come from a fixed list of the known CRT wall names, so
+       * they are the same in every job and file. The list covers the ICARUS CRT
+       * regions (`"Top"`, `"RimWest"`, ..., `"Bottom"`) and the SBND tagger
+       * volumes (`"volTaggerSideRight_0"`, ..., `"volTaggerBottom_0"`).
+       * An empty name has identifier `NoTagger` and the name `"unknown"` has
+       * identifier `UnknownTagger`.
+       *
+       * A name not in the list can't be stored without losing it, so it is an
+       * error: `std::invalid_argument` is thrown. This is also used when reading
+       * hits written before `tagger_id` was introduced, so that a file with a
+       * new tagger name fails to be read rather than losing that name; the name
+       * then needs to be added to the list in `CRTHit.cc`.
+       */
+      static uint32_t taggerID(std::string const& name);
+
+      /**
+       * Returns the name of the tagger with the identifier `id`.
+       *
+       * The name of `NoTagger` is empty, and the name of `UnknownTagger` and of
+       * any identifier not in the known list is `"unknown"`.
+       */
+      static std::string const& taggerName(uint32_t id);
+
+    };
+
+
+    /// Access by index to a sequence of values; `Cont` is a small view providing `valueAt()`.
+    template <typename Cont, typename Value>
+    class CRTHitIndexIterator {
+      Cont fCont; // a copy, so that the iterator outlives a temporary view
+      std::size_t fIndex = 0;
+
+    public:
+      using value_type = Value;
+      using reference = Value;
+      using difference_type = std::ptrdiff_t;
+      using iterator_category = std::forward_iterator_tag;
+
+      struct pointer { // a value with the arrow operator, for `it->first`
+        Value value;
+        Value const* operator->() const { return &value; }
+      };
+
+      CRTHitIndexIterator() = default;
+      CRTHitIndexIterator(Cont const& cont, std::size_t index)
+        : fCont(cont), fIndex(index) {}
+
+      Value operator*() const { return fCont.valueAt(fIndex); }
+      pointer operator->() const { return { **this }; }
+      CRTHitIndexIterator& operator++() { ++fIndex; return *this; }
+      CRTHitIndexIterator operator++(int) { auto old = *this; ++fIndex; return old; }
+      bool operator==(CRTHitIndexIterator const& other) const
+        { return fIndex == other.fIndex; }
+      bool operator!=(CRTHitIndexIterator const& other) const
+        { return fIndex != other.fIndex; }
+    };
+
+
+    /// Signals of one FEB in a `CRTHit` (mimics `std::vector<std::pair<int,float>>`).
+    class CRTHit::FEBPEs {
+      int const* fChannels = nullptr;
+      float const* fPEs = nullptr;
+      std::size_t fSize = 0;
+
+    public:
+      using value_type = ChannelPE_t;
+      using const_iterator = CRTHitIndexIterator<FEBPEs, ChannelPE_t>;
+      using iterator = const_iterator;
+
+      FEBPEs() = default;
+      FEBPEs(int const* channels, float const* pes, std::size_t size)
+        : fChannels(channels), fPEs(pes), fSize(size) {}
+
+      std::size_t size() const { return fSize; }
+      bool empty() const { return fSize == 0; }
+
+      int channel(std::size_t i) const { return fChannels[i]; } ///< Local channel of signal `i`.
+      float pe(std::size_t i) const { return fPEs[i]; } ///< PE of signal `i`.
+      ChannelPE_t valueAt(std::size_t i) const { return { fChannels[i], fPEs[i] }; }
+      ChannelPE_t operator[](std::size_t i) const { return valueAt(i); }
+
+      const_iterator begin() const { return { *this, 0 }; }
+      const_iterator end() const { return { *this, fSize }; }
+
+      /// Returns a copy of the signals in the format of the former `pesmap`.
+      std::vector<ChannelPE_t> toVector() const;
     };
 
+
+    /**
+     * Signal hit information of a `CRTHit` by FEB, mimicking the former
+     * `std::map< uint8_t, std::vector<std::pair<int,float> > > pesmap`:
+     *
+     *     for (auto const& [ feb, pes ]: hit.pesmap())
+     *       for (auto const& [ channel, pe ]: pes) ...
+     *
+     * Elements are returned by value (`std::pair<uint8_t, FEBPEs>`), and they
+     * are valid only as long as the hit is not modified.
+     */
+    class CRTHit::PEsMapView {
+      CRTHit const* fHit = nullptr;
+
+    public:
+      using key_type = uint8_t;
+      using mapped_type = FEBPEs;
+      using value_type = std::pair<uint8_t, FEBPEs>;
+      using const_iterator = CRTHitIndexIterator<PEsMapView, value_type>;
+      using iterator = const_iterator;
+
+      PEsMapView() = default;
+      explicit PEsMapView(CRTHit const& hit): fHit(&hit) {}
+
+      std::size_t size() const { return fHit->pes_feb.size(); }
+      bool empty() const { return fHit->pes_feb.empty(); }
+
+      const_iterator begin() const { return { *this, 0 }; }
+      const_iterator end() const { return { *this, size() }; }
+
+      /// Returns the iterator to the FEB with address `feb`, or `end()`.
+      const_iterator find(uint8_t feb) const { return { *this, indexOf(feb) }; }
+      std::size_t count(uint8_t feb) const { return indexOf(feb) < size()? 1: 0; }
+
+      /// Returns the signals of FEB `feb`; throws `std::out_of_range` if not present.
+      FEBPEs at(uint8_t feb) const;
+
+      value_type valueAt(std::size_t i) const;
+
+    private:
+      std::size_t indexOf(uint8_t feb) const; ///< Position of `feb`, `size()` if absent.
+    };
+
+
+    inline CRTHit::PEsMapView CRTHit::pesmap() const { return PEsMapView{ *this }; }
+
 } // namespace sbn::crt
 
 #endif
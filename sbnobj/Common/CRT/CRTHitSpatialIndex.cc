@@ -0,0 +1,218 @@
+#include "sbnobj/Common/CRT/CRTHitSpatialIndex.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace sbn::crt {
+
+  void CRTHitSpatialIndex::build(std::vector<CRTHit> const& hits, Config_t const& config) {
+    fPlanes.clear();
+
+    // hits with a non-finite position can't be placed in any cell: they are skipped
+    std::map<int, std::vector<std::size_t>> hitsByPlane;
+    for (std::size_t i = 0; i < hits.size(); ++i) {
+      CRTHit const& hit = hits[i];
+      if (!std::isfinite(hit.x_pos) || !std::isfinite(hit.y_pos) || !std::isfinite(hit.z_pos))
+        continue;
+      hitsByPlane[hit.plane].push_back(i);
+    }
+
+    for (auto const& [ plane, planeHits ]: hitsByPlane) {
+      PlaneGrid& grid = fPlanes[plane];
+      std::size_t const n = planeHits.size();
+
+      auto const coord = [&hits](std::size_t iHit, int axis)
+        { CRTHit const& hit = hits[iHit]; return (axis == 0)? hit.x_pos: (axis == 1)? hit.y_pos: hit.z_pos; };
+      auto const error = [&hits](std::size_t iHit, int axis)
+        { CRTHit const& hit = hits[iHit]; return std::abs((axis == 0)? hit.x_err: (axis == 1)? hit.y_err: hit.z_err); };
+
+      float lower[3], upper[3];
+      for (int axis = 0; axis < 3; ++axis) {
+        lower[axis] = upper[axis] = coord(planeHits.front(), axis);
+        for (std::size_t const iHit: planeHits) {
+          lower[axis] = std::min(lower[axis], coord(iHit, axis));
+          upper[axis] = std::max(upper[axis], coord(iHit, axis));
+          grid.maxErr = std::max(grid.maxErr, error(iHit, axis));
+        }
+        grid.origin[axis] = lower[axis];
+      }
+
+      // cells are enlarged until there are not many more cells than hits;
+      // the cell count is computed in floating point, since it may not fit an integer
+      std::size_t const maxCells = std::max<std::size_t>(64, 4 * n);
+      grid.cellSize = (config.cellSize > 0.0)? config.cellSize: 1.0;
+      double cells[3];
+      while (true) {
+        double nTotal = 1.0;
+        for (int axis = 0; axis < 3; ++axis) {
+          double const span = static_cast<double>(upper[axis]) - lower[axis];
+          cells[axis] = 1.0 + std::floor(span / grid.cellSize);
+          nTotal *= cells[axis];
+        }
+        if (nTotal <= maxCells) break;
+        grid.cellSize *= 2.0;
+      }
+      for (int axis = 0; axis < 3; ++axis) grid.nCells[axis] = static_cast<int>(cells[axis]);
+
+      // counting sort of the hits by cell
+      std::vector<std::size_t> hitCell(n);
+      grid.cellStart.assign(grid.nCells[0] * grid.nCells[1] * grid.nCells[2] + 1, 0);
+      for (std::size_t i = 0; i < n; ++i) {
+        int coords[3];
+        for (int axis = 0; axis < 3; ++axis) coords[axis] = grid.cellCoord(axis, coord(planeHits[i], axis));
+        hitCell[i] = grid.cellIndex(coords);
+        ++grid.cellStart[hitCell[i] + 1];
+      }
+      std::partial_sum(grid.cellStart.begin(), grid.cellStart.end(), grid.cellStart.begin());
+
+      std::vector<uint32_t> next(grid.cellStart.begin(), grid.cellStart.end() - 1);
+      grid.hit.resize(n);
+      for (int axis = 0; axis < 3; ++axis) {
+        grid.pos[axis].resize(n);
+        grid.err[axis].resize(n);
+      }
+      for (std::size_t i = 0; i < n; ++i) {
+        uint32_t const pos = next[hitCell[i]]++;
+        grid.hit[pos] = planeHits[i];
+        for (int axis = 0; axis < 3; ++axis) {
+          grid.pos[axis][pos] = coord(planeHits[i], axis);
+          grid.err[axis][pos] = error(planeHits[i], axis);
+        }
+      }
+    }
+  }
+
+
+  std::size_t CRTHitSpatialIndex::size(int plane) const {
+    PlaneGrid const* grid = planeGrid(plane);
+    return grid? grid->hit.size(): 0;
+  }
+
+
+  CRTHitSpatialIndex::Match_t CRTHitSpatialIndex::nearest(int plane, Point_t const& point) const {
+    Match_t match;
+    PlaneGrid const* grid = planeGrid(plane);
+    if (!grid) return match;
+
+    float const p[3] = { point.x, point.y, point.z };
+    int center[3], maxRing = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+      center[axis] = grid->cellCoord(axis, p[axis]);
+      maxRing = std::max({ maxRing, center[axis], grid->nCells[axis] - 1 - center[axis] });
+    }
+
+    // visits the cells in shells of increasing distance from the one of the point
+    float best2 = std::numeric_limits<float>::max();
+    for (int ring = 0; ring <= maxRing; ++ring) {
+      float const bound = (ring - 1) * grid->cellSize - grid->maxErr;
+      if ((bound > 0.0) && (bound * bound > best2)) break;
+
+      int lower[3], upper[3];
+      for (int axis = 0; axis < 3; ++axis) {
+        lower[axis] = std::max(center[axis] - ring, 0);
+        upper[axis] = std::min(center[axis] + ring, grid->nCells[axis] - 1);
+      }
+      int c[3];
+      for (c[2] = lower[2]; c[2] <= upper[2]; ++c[2]) {
+        for (c[1] = lower[1]; c[1] <= upper[1]; ++c[1]) {
+          for (c[0] = lower[0]; c[0] <= upper[0]; ++c[0]) {
+            if ((std::abs(c[0] - center[0]) != ring) && (std::abs(c[1] - center[1]) != ring)
+              && (std::abs(c[2] - center[2]) != ring)) continue; // inner shell
+            std::size_t const cell = grid->cellIndex(c);
+            for (uint32_t i = grid->cellStart[cell]; i < grid->cellStart[cell + 1]; ++i) {
+              float const d2 = grid->distance2(i, point);
+              if ((d2 < best2) || ((d2 == best2) && (grid->hit[i] < match.hit))) {
+                best2 = d2;
+                match.hit = grid->hit[i];
+              }
+            }
+          }
+        }
+      }
+    }
+    if (match.found()) match.distance = std::sqrt(best2);
+    return match;
+  }
+
+
+  std::vector<std::size_t> CRTHitSpatialIndex::withinRadius
+    (int plane, Point_t const& point, float radius) const
+  {
+    std::vector<std::size_t> found;
+    PlaneGrid const* grid = planeGrid(plane);
+    if (!grid || (radius < 0.0)) return found;
+
+    float const p[3] = { point.x, point.y, point.z };
+    float const reach = radius + grid->maxErr;
+    int lower[3], upper[3];
+    for (int axis = 0; axis < 3; ++axis) {
+      lower[axis] = grid->cellCoord(axis, p[axis] - reach);
+      upper[axis] = grid->cellCoord(axis, p[axis] + reach);
+    }
+
+    float const radius2 = radius * radius;
+    int c[3];
+    for (c[2] = lower[2]; c[2] <= upper[2]; ++c[2]) {
+      for (c[1] = lower[1]; c[1] <= upper[1]; ++c[1]) {
+        for (c[0] = lower[0]; c[0] <= upper[0]; ++c[0]) {
+          std::size_t const cell = grid->cellIndex(c);
+          for (uint32_t i = grid->cellStart[cell]; i < grid->cellStart[cell + 1]; ++i)
+            if (grid->distance2(i, point) <= radius2) found.push_back(grid->hit[i]);
+        }
+      }
+    }
+    std::sort(found.begin(), found.end());
+    return found;
+  }
+
+
+  std::vector<CRTHitSpatialIndex::Match_t> CRTHitSpatialIndex::nearest
+    (int plane, std::vector<Point_t> const& points) const
+  {
+    std::vector<Match_t> matches;
+    matches.reserve(points.size());
+    for (Point_t const& point: points) matches.push_back(nearest(plane, point));
+    return matches;
+  }
+
+
+  std::vector<std::vector<std::size_t>> CRTHitSpatialIndex::withinRadius
+    (int plane, std::vector<Point_t> const& points, float radius) const
+  {
+    std::vector<std::vector<std::size_t>> found;
+    found.reserve(points.size());
+    for (Point_t const& point: points) found.push_back(withinRadius(plane, point, radius));
+    return found;
+  }
+
+
+  float CRTHitSpatialIndex::distance(CRTHit const& hit, Point_t const& point) {
+    float const dx = std::max(std::abs(point.x - hit.x_pos) - std::abs(hit.x_err), 0.0f);
+    float const dy = std::max(std::abs(point.y - hit.y_pos) - std::abs(hit.y_err), 0.0f);
+    float const dz = std::max(std::abs(point.z - hit.z_pos) - std::abs(hit.z_err), 0.0f);
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+  }
+
+
+  auto CRTHitSpatialIndex::planeGrid(int plane) const -> PlaneGrid const* {
+    auto const it = fPlanes.find(plane);
+    return (it == fPlanes.end())? nullptr: &(it->second);
+  }
+
+
+  int CRTHitSpatialIndex::PlaneGrid::cellCoord(int axis, float coord) const {
+    float const cell = std::floor((coord - origin[axis]) / cellSize);
+    if (!(cell > 0.0f)) return 0; // also for a non-finite `coord`
+    return (cell < nCells[axis] - 1)? static_cast<int>(cell): nCells[axis] - 1;
+  }
+
+
+  float CRTHitSpatialIndex::PlaneGrid::distance2(std::size_t i, Point_t const& point) const {
+    float const dx = std::max(std::abs(point.x - pos[0][i]) - err[0][i], 0.0f);
+    float const dy = std::max(std::abs(point.y - pos[1][i]) - err[1][i], 0.0f);
+    float const dz = std::max(std::abs(point.z - pos[2][i]) - err[2][i], 0.0f);
+    return dx * dx + dy * dy + dz * dz;
+  }
+
+} // namespace sbn::crt
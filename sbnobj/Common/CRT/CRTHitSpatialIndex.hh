@@ -0,0 +1,126 @@
+/**
+ * \class CRTHitSpatialIndex
+ *
+ * \ingroup crt
+ *
+ * \brief Index of CRT hits by position on each CRT plane, for track matching
+ *
+ */
+
+#ifndef CRTHitSpatialIndex_hh_
+#define CRTHitSpatialIndex_hh_
+
+#include "sbnobj/Common/CRT/CRTHit.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <vector>
+
+namespace sbn::crt {
+
+  /**
+   * Arranges the hits of each CRT plane (`CRTHit::plane`) in a uniform grid of
+   * cubic cells, so that the hits close to a point (e.g. a TPC track
+   * extrapolated to a CRT wall) are found without scanning all the hits.
+   *
+   * The distance of a point from a hit takes into account the position
+   * uncertainty of the hit: it is the distance from the box of half-sizes
+   * `x_err`, `y_err` and `z_err` around the hit position, and it is `0` for
+   * points inside that box.
+   *
+   *     sbn::crt::CRTHitSpatialIndex const index{ hits };
+   *     auto const match = index.nearest(plane, { x, y, z });
+   *     if (match.found()) ... hits[match.hit] ...
+   *
+   * Query results refer to the hits by their index in the original collection.
+   * The index does not refer to the hit collection after construction.
+   * Hits with a non-finite position (NaN or infinite coordinates) are not
+   * included in the index, and they are never returned by the queries.
+   */
+  class CRTHitSpatialIndex {
+
+  public:
+
+    /// Index for no hit.
+    static constexpr std::size_t NoHit = std::numeric_limits<std::size_t>::max();
+
+    /// A point in space [cm].
+    struct Point_t { float x, y, z; };
+
+    /// Result of a nearest hit query.
+    struct Match_t {
+      std::size_t hit = NoHit; ///< Index of the hit in the original collection.
+      float distance = std::numeric_limits<float>::max(); ///< Distance from the hit [cm].
+
+      bool found() const { return hit != NoHit; }
+    };
+
+    struct Config_t {
+      float cellSize = 20.0; ///< Size of the grid cells [cm] (enlarged for sparse planes).
+    };
+
+    CRTHitSpatialIndex() = default;
+
+    /// Builds the index of `hits`.
+    explicit CRTHitSpatialIndex(std::vector<CRTHit> const& hits) { build(hits); }
+
+    /// Builds the index of `hits` with the specified configuration.
+    CRTHitSpatialIndex(std::vector<CRTHit> const& hits, Config_t const& config)
+      { build(hits, config); }
+
+    /// Replaces the content of the index with the `hits`.
+    void build(std::vector<CRTHit> const& hits) { build(hits, Config_t{}); }
+
+    /// Replaces the content of the index with the `hits`, with the specified configuration.
+    void build(std::vector<CRTHit> const& hits, Config_t const& config);
+
+    /// Returns the number of hits on `plane`.
+    std::size_t size(int plane) const;
+
+    /// Returns the hit on `plane` closest to `point`.
+    Match_t nearest(int plane, Point_t const& point) const;
+
+    /// Returns the hits on `plane` within `radius` from `point`, sorted by index.
+    std::vector<std::size_t> withinRadius(int plane, Point_t const& point, float radius) const;
+
+    /// Returns `nearest(plane, point)` for each of the `points`.
+    std::vector<Match_t> nearest(int plane, std::vector<Point_t> const& points) const;
+
+    /// Returns `withinRadius(plane, point, radius)` for each of the `points`.
+    std::vector<std::vector<std::size_t>> withinRadius
+      (int plane, std::vector<Point_t> const& points, float radius) const;
+
+    /// Returns the distance of `point` from `hit`, including the position uncertainty.
+    static float distance(CRTHit const& hit, Point_t const& point);
+
+  private:
+
+    /// Hits of a plane, with position and uncertainty stored by grid cell.
+    struct PlaneGrid {
+      float origin[3] = { 0.0, 0.0, 0.0 }; ///< Lower corner of the grid.
+      float cellSize = 1.0;
+      int nCells[3] = { 1, 1, 1 };
+      float maxErr = 0.0; ///< Largest uncertainty of the hits on any axis.
+
+      std::vector<uint32_t> cellStart; ///< First hit of each cell, plus the total.
+      std::vector<std::size_t> hit; ///< Original index of each hit.
+      std::vector<float> pos[3]; ///< Position of each hit.
+      std::vector<float> err[3]; ///< Position uncertainty of each hit.
+
+      int cellCoord(int axis, float coord) const;
+      std::size_t cellIndex(int const coords[3]) const
+        { return (static_cast<std::size_t>(coords[2]) * nCells[1] + coords[1]) * nCells[0] + coords[0]; }
+      float distance2(std::size_t i, Point_t const& point) const;
+    };
+
+    std::map<int, PlaneGrid> fPlanes;
+
+    PlaneGrid const* planeGrid(int plane) const;
+
+  };
+
+} // namespace sbn::crt
+
+#endif
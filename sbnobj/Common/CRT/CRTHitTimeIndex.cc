@@ -0,0 +1,68 @@
+#include "sbnobj/Common/CRT/CRTHitTimeIndex.hh"
+
+#include <algorithm>
+#include <numeric>
+
+namespace sbn::crt {
+
+  void CRTHitTimeIndex::build(std::vector<CRTHit> const& hits) {
+    std::size_t const n = hits.size();
+    for (TimeRef_t const ref: { T0, T1 }) {
+      std::vector<int64_t> times(n);
+      for (std::size_t i = 0; i < n; ++i)
+        times[i] = (ref == T0)? hits[i].ts0(): hits[i].ts1();
+
+      SortedTimes& sorted = fByTime[ref];
+      sorted.index.resize(n);
+      std::iota(sorted.index.begin(), sorted.index.end(), 0);
+      std::stable_sort(sorted.index.begin(), sorted.index.end(),
+        [&times](std::size_t a, std::size_t b){ return times[a] < times[b]; });
+
+      sorted.time.resize(n);
+      for (std::size_t i = 0; i < n; ++i) sorted.time[i] = times[sorted.index[i]];
+    }
+  }
+
+
+  CRTHitTimeIndex::HitRange CRTHitTimeIndex::range
+    (TimeRef_t ref, int64_t start, int64_t stop) const
+  {
+    std::vector<int64_t> const& times = fByTime[ref].time;
+    auto const first = std::lower_bound(times.begin(), times.end(), start);
+    auto const last = std::upper_bound(first, times.end(), stop);
+    return makeRange(ref, first - times.begin(), last - times.begin());
+  }
+
+
+  CRTHitTimeIndex::HitRange CRTHitTimeIndex::window
+    (TimeRef_t ref, int64_t time, int64_t delta) const
+  {
+    return range(ref, time - delta, time + delta);
+  }
+
+
+  std::vector<CRTHitTimeIndex::HitRange> CRTHitTimeIndex::windows
+    (TimeRef_t ref, std::vector<int64_t> const& times, int64_t delta) const
+  {
+    std::vector<HitRange> ranges;
+    ranges.reserve(times.size());
+
+    if (!std::is_sorted(times.begin(), times.end())) {
+      for (int64_t const time: times) ranges.push_back(window(ref, time, delta));
+      return ranges;
+    }
+
+    // two-pointer sweep: both window edges only move forward
+    std::vector<int64_t> const& hitTimes = fByTime[ref].time;
+    std::size_t const n = hitTimes.size();
+    std::size_t first = 0, last = 0;
+    for (int64_t const time: times) {
+      while ((first < n) && (hitTimes[first] < time - delta)) ++first;
+      if (last < first) last = first;
+      while ((last < n) && (hitTimes[last] <= time + delta)) ++last;
+      ranges.push_back(makeRange(ref, first, last));
+    }
+    return ranges;
+  }
+
+} // namespace sbn::crt
@@ -0,0 +1,102 @@
+/**
+ * \class CRTHitTimeIndex
+ *
+ * \ingroup crt
+ *
+ * \brief Index of CRT hits sorted by time, for coincidence window queries
+ *
+ */
+
+#ifndef CRTHitTimeIndex_hh_
+#define CRTHitTimeIndex_hh_
+
+#include "sbnobj/Common/CRT/CRTHit.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace sbn::crt {
+
+  /**
+   * Sorts the hits of a collection by their `ts0()` and by their `ts1()`,
+   * and returns the hits with time in a window without scanning the collection.
+   *
+   *     sbn::crt::CRTHitTimeIndex const index{ hits };
+   *     for (std::size_t iHit: index.window(sbn::crt::CRTHitTimeIndex::T1, flashTime, 100))
+   *       ... hits[iHit] ...
+   *
+   * Queries return the indices of the hits in the original collection, sorted
+   * by time. Single queries take logarithmic time; `windows()` answers a sorted
+   * list of queries with a single linear sweep.
+   * The index does not refer to the hit collection after construction.
+   */
+  class CRTHitTimeIndex {
+
+  public:
+
+    /// Which time of the hit is used.
+    enum TimeRef_t { T0, T1 };
+
+    /// Indices of hits (in the original collection) in a time window.
+    struct HitRange {
+      std::size_t const* first = nullptr;
+      std::size_t const* last = nullptr;
+
+      std::size_t const* begin() const { return first; }
+      std::size_t const* end() const { return last; }
+      std::size_t size() const { return last - first; }
+      bool empty() const { return first == last; }
+      std::size_t operator[](std::size_t i) const { return first[i]; }
+    };
+
+    CRTHitTimeIndex() = default;
+
+    /// Builds the index of `hits`.
+    explicit CRTHitTimeIndex(std::vector<CRTHit> const& hits) { build(hits); }
+
+    /// Replaces the content of the index with the `hits`.
+    void build(std::vector<CRTHit> const& hits);
+
+    std::size_t size() const { return fByTime[T0].index.size(); }
+    bool empty() const { return fByTime[T0].index.empty(); }
+
+    /// Returns the hits with time `ref` between `time - delta` and `time + delta` (included) [ns].
+    HitRange window(TimeRef_t ref, int64_t time, int64_t delta) const;
+
+    /// Returns the hits with time `ref` between `start` and `stop` (included) [ns].
+    HitRange range(TimeRef_t ref, int64_t start, int64_t stop) const;
+
+    /**
+     * Returns `window(ref, time, delta)` for each of the `times`, in order.
+     *
+     * If `times` are sorted, all the windows are found in a single sweep of
+     * the index (time linear in the number of hits and queries); otherwise
+     * each window is searched independently.
+     */
+    std::vector<HitRange> windows
+      (TimeRef_t ref, std::vector<int64_t> const& times, int64_t delta) const;
+
+    /// Returns the hit times `ref`, sorted [ns].
+    std::vector<int64_t> const& sortedTimes(TimeRef_t ref) const { return fByTime[ref].time; }
+
+    /// Returns the indices of the hits, sorted by time `ref`.
+    std::vector<std::size_t> const& sortedHits(TimeRef_t ref) const { return fByTime[ref].index; }
+
+  private:
+
+    struct SortedTimes {
+      std::vector<int64_t> time; ///< Sorted times.
+      std::vector<std::size_t> index; ///< Hit index for each time in `time`.
+    };
+
+    SortedTimes fByTime[2]; ///< Hits sorted by each of the times.
+
+    HitRange makeRange(TimeRef_t ref, std::size_t first, std::size_t last) const
+      { auto const* base = fByTime[ref].index.data(); return { base + first, base + last }; }
+
+  };
+
+} // namespace sbn::crt
+
+#endif
@@ -0,0 +1,94 @@
+#include "sbnobj/Common/CRT/CRTTrackBuilder.hh"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sbn::crt {
+
+  auto CRTTrackBuilder::build(std::vector<CRTHit> const& hits) const -> Result_t {
+    return build(hits, CRTHitTimeIndex{ hits });
+  }
+
+
+  auto CRTTrackBuilder::build
+    (std::vector<CRTHit> const& hits, CRTHitTimeIndex const& index) const -> Result_t
+  {
+    std::vector<std::pair<std::size_t, std::size_t>> const pairs = candidatePairs(hits, index);
+
+    Result_t result;
+    result.tracks.reserve(pairs.size());
+    result.trackHits.reserve(2 * pairs.size());
+    for (auto const& [ hit1, hit2 ]: pairs) {
+      std::size_t const iTrack = result.tracks.size();
+      result.tracks.push_back(makeTrack(hits[hit1], hits[hit2]));
+      result.trackHits.emplace_back(iTrack, hit1);
+      result.trackHits.emplace_back(iTrack, hit2);
+    }
+    return result;
+  }
+
+
+  std::vector<std::pair<std::size_t, std::size_t>> CRTTrackBuilder::candidatePairs
+    (std::vector<CRTHit> const& hits, CRTHitTimeIndex const& index) const
+  {
+    std::vector<int64_t> const& times = index.sortedTimes(fConfig.timeRef);
+    std::vector<std::size_t> const& sorted = index.sortedHits(fConfig.timeRef);
+    std::size_t const n = sorted.size();
+
+    std::vector<std::pair<std::size_t, std::size_t>> pairs;
+    for (std::size_t a = 0; a < n; ++a) {
+      int const plane = hits[sorted[a]].plane;
+      for (std::size_t b = a + 1; (b < n) && (times[b] - times[a] <= fConfig.timeWindow); ++b) {
+        if (hits[sorted[b]].plane != plane) pairs.emplace_back(sorted[a], sorted[b]);
+      }
+    }
+
+    // group by pair of planes, keeping the time order within each group
+    auto const planePair = [&hits](std::pair<std::size_t, std::size_t> const& p)
+      {
+        int const plane1 = hits[p.first].plane, plane2 = hits[p.second].plane;
+        return std::make_pair(std::min(plane1, plane2), std::max(plane1, plane2));
+      };
+    std::stable_sort(pairs.begin(), pairs.end(),
+      [&planePair](auto const& a, auto const& b){ return planePair(a) < planePair(b); });
+    return pairs;
+  }
+
+
+  CRTTrack CRTTrackBuilder::makeTrack(CRTHit const& hit1, CRTHit const& hit2) {
+    CRTTrack track;
+
+    track.peshit = hit1.peshit + hit2.peshit;
+    track.ts0_s = (hit1.ts0_s + hit2.ts0_s) / 2.;
+    track.ts0_s_err = std::abs(static_cast<double>(hit1.ts0_s) - static_cast<double>(hit2.ts0_s)) / 2.;
+    track.ts0_ns = (hit1.ts0_ns + hit2.ts0_ns) / 2.;
+    track.ts0_ns_err = std::abs(hit1.ts0_ns - hit2.ts0_ns) / 2.;
+    track.ts1_ns = (hit1.ts1_ns + hit2.ts1_ns) / 2.;
+    track.ts1_ns_err = std::abs(hit1.ts1_ns - hit2.ts1_ns) / 2.;
+    track.plane1 = hit1.plane;
+    track.plane2 = hit2.plane;
+
+    track.x1_pos = hit1.x_pos; track.x1_err = hit1.x_err;
+    track.y1_pos = hit1.y_pos; track.y1_err = hit1.y_err;
+    track.z1_pos = hit1.z_pos; track.z1_err = hit1.z_err;
+    track.x2_pos = hit2.x_pos; track.x2_err = hit2.x_err;
+    track.y2_pos = hit2.y_pos; track.y2_err = hit2.y_err;
+    track.z2_pos = hit2.z_pos; track.z2_err = hit2.z_err;
+
+    track.ts0_ns_h1 = hit1.ts0_ns;
+    track.ts0_ns_err_h1 = hit1.ts0_ns_corr;
+    track.ts0_ns_h2 = hit2.ts0_ns;
+    track.ts0_ns_err_h2 = hit2.ts0_ns_corr;
+
+    float const dx = hit2.x_pos - hit1.x_pos;
+    float const dy = hit2.y_pos - hit1.y_pos;
+    float const dz = hit2.z_pos - hit1.z_pos;
+    track.length = std::sqrt(dx * dx + dy * dy + dz * dz);
+    track.thetaxy = std::atan2(dx, dy);
+    track.phizy = std::atan2(dz, dy);
+
+    track.complete = true;
+    return track;
+  }
+
+} // namespace sbn::crt
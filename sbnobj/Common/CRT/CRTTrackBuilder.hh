@@ -0,0 +1,74 @@
+/**
+ * \class CRTTrackBuilder
+ *
+ * \ingroup crt
+ *
+ * \brief Builds CRT tracks from pairs of CRT hits close in time
+ *
+ */
+
+#ifndef CRTTrackBuilder_hh_
+#define CRTTrackBuilder_hh_
+
+#include "sbnobj/Common/CRT/CRTHit.hh"
+#include "sbnobj/Common/CRT/CRTTrack.hh"
+#include "sbnobj/Common/CRT/CRTHitTimeIndex.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace sbn::crt {
+
+  /**
+   * Creates a `CRTTrack` from each pair of hits on different planes with
+   * times within a window.
+   *
+   * The candidate pairs are found with a sweep of the hits sorted by time
+   * (`CRTHitTimeIndex`), and they are grouped by pair of planes. Each track is
+   * then made from its pair of hits by `makeTrack()`.
+   *
+   * The first hit of each track is the earlier one. The result includes, for
+   * each track, its two hits as (track index, hit index) pairs, ready to be
+   * turned into `art::Assns<CRTTrack, CRTHit>`.
+   */
+  class CRTTrackBuilder {
+
+  public:
+
+    struct Config_t {
+      int64_t timeWindow = 100; ///< Largest time difference between the hits [ns].
+      CRTHitTimeIndex::TimeRef_t timeRef = CRTHitTimeIndex::T0; ///< Time of the hits to compare.
+    };
+
+    struct Result_t {
+      std::vector<CRTTrack> tracks; ///< The tracks, grouped by pair of planes.
+      std::vector<std::pair<std::size_t, std::size_t>> trackHits; ///< (track, hit) index pairs.
+    };
+
+    CRTTrackBuilder(): CRTTrackBuilder(Config_t{}) {}
+    explicit CRTTrackBuilder(Config_t const& config): fConfig(config) {}
+
+    /// Returns the tracks from the `hits`.
+    Result_t build(std::vector<CRTHit> const& hits) const;
+
+    /// Returns the tracks from the `hits`, using an existing time `index` of them.
+    Result_t build(std::vector<CRTHit> const& hits, CRTHitTimeIndex const& index) const;
+
+    /// Returns the pairs of hits (indices, earlier first) which make tracks, grouped by planes.
+    std::vector<std::pair<std::size_t, std::size_t>> candidatePairs
+      (std::vector<CRTHit> const& hits, CRTHitTimeIndex const& index) const;
+
+    /// Returns the track made of `hit1` and `hit2`.
+    static CRTTrack makeTrack(CRTHit const& hit1, CRTHit const& hit2);
+
+  private:
+
+    Config_t fConfig;
+
+  };
+
+} // namespace sbn::crt
+
+#endif
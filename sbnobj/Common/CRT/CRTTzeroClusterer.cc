@@ -0,0 +1,104 @@
+#include "sbnobj/Common/CRT/CRTTzeroClusterer.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+  /// Returns `value` rounded and limited to the range of `T`.
+  template <typename T>
+  T clampTo(double value) {
+    double const rounded = std::round(value);
+    if (rounded <= std::numeric_limits<T>::lowest()) return std::numeric_limits<T>::lowest();
+    if (rounded >= std::numeric_limits<T>::max()) return std::numeric_limits<T>::max();
+    return static_cast<T>(rounded);
+  }
+
+} // local namespace
+
+
+namespace sbn::crt {
+
+  CRTTzeroClusterer::CRTTzeroClusterer(Config_t const& config): fConfig(config) {
+    if (fConfig.planes.size() > NPlaneSlots) {
+      throw std::runtime_error("sbn::crt::CRTTzeroClusterer: "
+        + std::to_string(fConfig.planes.size()) + " planes configured, but only "
+        + std::to_string(NPlaneSlots) + " can be counted.");
+    }
+  }
+
+
+  auto CRTTzeroClusterer::cluster(std::vector<CRTHit> const& hits) const -> Result_t {
+    return cluster(hits, CRTHitTimeIndex{ hits });
+  }
+
+
+  auto CRTTzeroClusterer::cluster
+    (std::vector<CRTHit> const& hits, CRTHitTimeIndex const& index) const -> Result_t
+  {
+    std::vector<int64_t> const& times = index.sortedTimes(CRTHitTimeIndex::T0);
+    std::vector<std::size_t> const& sorted = index.sortedHits(CRTHitTimeIndex::T0);
+    std::size_t const n = sorted.size();
+
+    Result_t result;
+    result.tzeroHits.reserve(n);
+
+    std::size_t first = 0;
+    while (first < n) {
+      std::size_t const iTzero = result.tzeros.size();
+      int64_t const start = times[first];
+
+      CRTTzero tzero; // its constructor leaves the counters uninitialized
+      std::fill(std::begin(tzero.nhits), std::end(tzero.nhits), 0);
+      std::fill(std::begin(tzero.pes), std::end(tzero.pes), 0.0);
+      // times are summed relative to the first hit, for precision
+      double sumT0 = 0.0, sumT0sq = 0.0, sumT1 = 0.0, sumT1sq = 0.0;
+      uint64_t minSec = hits[sorted[first]].ts0_s, maxSec = minSec;
+
+      std::size_t last = first;
+      for (; (last < n) && (times[last] - start <= fConfig.timeWindow); ++last) {
+        CRTHit const& hit = hits[sorted[last]];
+        double const t0 = times[last] - start;
+        double const t1 = hit.ts1();
+        sumT0 += t0; sumT0sq += t0 * t0;
+        sumT1 += t1; sumT1sq += t1 * t1;
+        minSec = std::min(minSec, hit.ts0_s);
+        maxSec = std::max(maxSec, hit.ts0_s);
+
+        std::size_t const slot = planeSlot(hit.plane);
+        if (slot < NPlaneSlots) {
+          ++tzero.nhits[slot];
+          tzero.pes[slot] += hit.peshit;
+        }
+        result.tzeroHits.emplace_back(iTzero, sorted[last]);
+      }
+
+      double const nHits = last - first;
+      double const meanT0 = sumT0 / nHits, meanT1 = sumT1 / nHits;
+      int64_t const t0 = start + static_cast<int64_t>(std::round(meanT0));
+      tzero.ts0_s = clampTo<uint32_t>(t0 / 1'000'000'000LL);
+      tzero.ts0_ns = clampTo<uint32_t>(t0 % 1'000'000'000LL);
+      tzero.ts0_s_err = clampTo<uint16_t>(maxSec - minSec);
+      tzero.ts0_ns_err = clampTo<uint16_t>(std::sqrt(std::max(sumT0sq / nHits - meanT0 * meanT0, 0.0)));
+      tzero.ts1_ns = clampTo<int32_t>(meanT1);
+      tzero.ts1_ns_err = clampTo<uint16_t>(std::sqrt(std::max(sumT1sq / nHits - meanT1 * meanT1, 0.0)));
+
+      result.tzeros.push_back(tzero);
+      first = last;
+    }
+    return result;
+  }
+
+
+  std::size_t CRTTzeroClusterer::planeSlot(int plane) const {
+    if (fConfig.planes.empty())
+      return ((plane >= 0) && (static_cast<std::size_t>(plane) < NPlaneSlots))? plane: NPlaneSlots;
+    auto const it = std::find(fConfig.planes.begin(), fConfig.planes.end(), plane);
+    return (it == fConfig.planes.end())? NPlaneSlots: (it - fConfig.planes.begin());
+  }
+
+} // namespace sbn::crt
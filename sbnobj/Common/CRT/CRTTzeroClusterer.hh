@@ -0,0 +1,78 @@
+/**
+ * \class CRTTzeroClusterer
+ *
+ * \ingroup crt
+ *
+ * \brief Groups CRT hits close in time into CRT T0 objects
+ *
+ */
+
+#ifndef CRTTzeroClusterer_hh_
+#define CRTTzeroClusterer_hh_
+
+#include "sbnobj/Common/CRT/CRTHit.hh"
+#include "sbnobj/Common/CRT/CRTTzero.hh"
+#include "sbnobj/Common/CRT/CRTHitTimeIndex.hh"
+
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace sbn::crt {
+
+  /**
+   * Clusters the hits by `ts0()` with a single sweep of the hits sorted by time.
+   *
+   * A cluster starts with the earliest hit not yet clustered, and includes all
+   * the following hits within `timeWindow` from it. For each cluster, a
+   * `CRTTzero` is created with the average times of the hits, their spread
+   * as uncertainty, and the number of hits and PE (`peshit`) on each plane.
+   *
+   * The planes are counted in the slots of `CRTTzero::nhits` and
+   * `CRTTzero::pes`: plane numbers are used as slot index, unless a list of
+   * `planes` is configured, in which case the slot is the position of the
+   * plane in that list. Hits on planes without a slot are clustered but not
+   * counted.
+   *
+   * The result includes the hits of each T0 as (T0 index, hit index) pairs,
+   * ready to be turned into `art::Assns<CRTTzero, CRTHit>`.
+   */
+  class CRTTzeroClusterer {
+
+  public:
+
+    /// Number of plane slots in `CRTTzero`.
+    static constexpr std::size_t NPlaneSlots = sizeof(CRTTzero::nhits) / sizeof(CRTTzero::nhits[0]);
+
+    struct Config_t {
+      int64_t timeWindow = 100; ///< Largest time from the first hit of the cluster [ns].
+      std::vector<int> planes; ///< Plane number for each slot (empty: slot is plane number).
+    };
+
+    struct Result_t {
+      std::vector<CRTTzero> tzeros; ///< The T0's, sorted by time.
+      std::vector<std::pair<std::size_t, std::size_t>> tzeroHits; ///< (T0, hit) index pairs.
+    };
+
+    CRTTzeroClusterer(): CRTTzeroClusterer(Config_t{}) {}
+    explicit CRTTzeroClusterer(Config_t const& config);
+
+    /// Returns the T0's from the `hits`.
+    Result_t cluster(std::vector<CRTHit> const& hits) const;
+
+    /// Returns the T0's from the `hits`, using an existing time `index` of them.
+    Result_t cluster(std::vector<CRTHit> const& hits, CRTHitTimeIndex const& index) const;
+
+    /// Returns the slot of `plane`, `NPlaneSlots` if none.
+    std::size_t planeSlot(int plane) const;
+
+  private:
+
+    Config_t fConfig;
+
+  };
+
+} // namespace sbn::crt
+
+#endif
@@ -0,0 +1,88 @@
+/**
+ * @file   sbnobj/Common/PMT/Data/ConfigurationHash.h
+ * @brief  Utility to compute content hashes of the PMT configuration classes.
+ * 
+ * This is a header-only library.
+ */
+ 
+#ifndef SBNOBJ_COMMON_PMT_DATA_CONFIGURATIONHASH_H
+#define SBNOBJ_COMMON_PMT_DATA_CONFIGURATIONHASH_H
+
+// SBN libraries
+#include "sbnobj/Common/Utilities/HashMixing.h" // sbn::details::mixHash()
+
+// C/C++ standard libraries
+#include <string>
+#include <type_traits> // std::is_integral_v, std::is_enum_v
+#include <limits> // std::numeric_limits<>
+#include <cmath> // std::isnan()
+#include <cstring> // std::memcpy()
+#include <cstdint> // std::uint64_t, std::uint32_t
+
+
+//------------------------------------------------------------------------------
+namespace sbn::details {
+  
+  /**
+   * @brief Accumulates values into a 64-bit hash.
+   * 
+   * The hash depends only on the sequence of the values added, not on the
+   * platform or on the process: integral values are added by value, floating
+   * point ones by their bit pattern and strings character by character.
+   * Floating point values comparing equal have the same hash (`-0.0` is added
+   * as `0.0`), and all NaN values are added as the same one.
+   * Each value is folded in the hash with `sbn::details::mixHash()`.
+   * 
+   * Example:
+   * ~~~~{.cpp}
+   * std::uint64_t const hash = sbn::details::ConfigurationHasher{}
+   *   .add(boardName).add(boardID).add(postTriggerFrac).value();
+   * ~~~~
+   */
+  class ConfigurationHasher {
+  
+    std::uint64_t fHash = 0U; ///< Current value of the hash.
+    
+    /// Folds a 64-bit value into the hash.
+    void mix(std::uint64_t value) { fHash = mixHash(fHash, value); }
+      
+      public:
+    
+    /// Adds an integral or enumerator `value` to the hash.
+    template <typename T>
+    std::enable_if_t
+      <std::is_integral_v<T> || std::is_enum_v<T>, ConfigurationHasher&>
+    add(T value) { mix(static_cast<std::uint64_t>(value)); return *this; }
+    
+    /// Adds a single precision floating point `value` to the hash.
+    ConfigurationHasher& add(float value)
+      {
+        // one bit pattern for zero and one for NaN, whatever the sign/payload
+        if (value == 0.0f) value = 0.0f;
+        else if (std::isnan(value))
+          value = std::numeric_limits<float>::quiet_NaN();
+        std::uint32_t bits;
+        static_assert(sizeof(bits) == sizeof(value));
+        std::memcpy(&bits, &value, sizeof(bits));
+        return add(bits);
+      }
+    
+    /// Adds a string to the hash (including its length).
+    ConfigurationHasher& add(std::string const& s)
+      {
+        add(s.size());
+        for (char const c: s) add(static_cast<unsigned char>(c));
+        return *this;
+      }
+    
+    /// Returns the current value of the hash.
+    std::uint64_t value() const { return fHash; }
+  
+  }; // class ConfigurationHasher
+  
+} // namespace sbn::details
+
+
+//------------------------------------------------------------------------------
+
+#endif // SBNOBJ_COMMON_PMT_DATA_CONFIGURATIONHASH_H
@@ -0,0 +1,66 @@
+/**
+ * @file   sbnobj/Common/PMT/Data/PMTchannelTimingTable.cxx
+ * @brief  Per-channel timing information from the PMT readout configuration.
+ * @see    sbnobj/Common/PMT/Data/PMTchannelTimingTable.h
+ */
+
+// library header
+#include "sbnobj/Common/PMT/Data/PMTchannelTimingTable.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::max()
+
+
+//------------------------------------------------------------------------------
+sbn::PMTchannelTimingTable::PMTchannelTimingTable
+  (sbn::PMTconfiguration const& config)
+{
+  std::size_t nEntries = 0U;
+  for (sbn::V1730Configuration const& board: config.boards) {
+    for (sbn::V1730channelConfiguration const& channel: board.channels) {
+      if (!channel.hasChannelID()) continue;
+      nEntries = std::max<std::size_t>(nEntries, channel.channelID + 1U);
+    } // for channels
+  } // for boards
+  resize(nEntries);
+  
+  for (sbn::V1730Configuration const& board: config.boards) {
+  
+    // all the channels of a board share the same timing
+    std::uint32_t const preTicks = board.preTriggerTicks();
+    std::uint32_t const postTicks = board.postTriggerTicks();
+    float const preTime = board.preTriggerTime();
+    float const postTime = board.postTriggerTime();
+    
+    for (sbn::V1730channelConfiguration const& channel: board.channels) {
+      if (!channel.hasChannelID()) continue;
+      raw::Channel_t const ID = channel.channelID;
+      if (fPresent[ID]) continue; // first appearance wins
+      
+      fPresent[ID] = 1U;
+      fPreTriggerTicks[ID] = preTicks;
+      fPostTriggerTicks[ID] = postTicks;
+      fPreTriggerTime[ID] = preTime;
+      fPostTriggerTime[ID] = postTime;
+      fEnabled[ID] = channel.enabled? 1U: 0U;
+      fRelativeThreshold[ID] = channel.relativeThreshold();
+    } // for channels
+  
+  } // for boards
+  
+} // sbn::PMTchannelTimingTable::PMTchannelTimingTable()
+
+
+//------------------------------------------------------------------------------
+void sbn::PMTchannelTimingTable::resize(std::size_t n) {
+  fPresent.assign(n, 0U);
+  fPreTriggerTicks.assign(n, 0U);
+  fPostTriggerTicks.assign(n, 0U);
+  fPreTriggerTime.assign(n, 0.0f);
+  fPostTriggerTime.assign(n, 0.0f);
+  fEnabled.assign(n, 0U);
+  fRelativeThreshold.assign(n, 0);
+} // sbn::PMTchannelTimingTable::resize()
+
+
+//------------------------------------------------------------------------------
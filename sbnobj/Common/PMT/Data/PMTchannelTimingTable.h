@@ -0,0 +1,218 @@
+/**
+ * @file   sbnobj/Common/PMT/Data/PMTchannelTimingTable.h
+ * @brief  Per-channel timing information from the PMT readout configuration.
+ * @see    sbnobj/Common/PMT/Data/PMTchannelTimingTable.cxx
+ */
+ 
+#ifndef SBNOBJ_COMMON_PMT_DATA_PMTCHANNELTIMINGTABLE_H
+#define SBNOBJ_COMMON_PMT_DATA_PMTCHANNELTIMINGTABLE_H
+
+// SBN libraries
+#include "sbnobj/Common/PMT/Data/PMTconfiguration.h"
+
+// LArSoft libraries
+#include "lardataobj/RawData/OpDetWaveform.h" // raw::Channel_t
+
+// C/C++ standard libraries
+#include <vector>
+#include <new> // std::align_val_t
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t, std::uint8_t
+
+
+//------------------------------------------------------------------------------
+namespace sbn {
+  
+  namespace details {
+  
+    /// Allocator aligning the allocated memory to `Alignment` bytes.
+    template <typename T, std::size_t Alignment>
+    struct AlignedAllocator {
+    
+      static_assert(Alignment >= alignof(T));
+      
+      using value_type = T;
+      
+      template <typename U>
+      struct rebind { using other = AlignedAllocator<U, Alignment>; };
+      
+      AlignedAllocator() = default;
+      template <typename U>
+      AlignedAllocator(AlignedAllocator<U, Alignment> const&) noexcept {}
+      
+      T* allocate(std::size_t n)
+        {
+          return static_cast<T*>(::operator new
+            (n * sizeof(T), std::align_val_t{ Alignment }));
+        }
+      
+      void deallocate(T* p, std::size_t) noexcept
+        { ::operator delete(p, std::align_val_t{ Alignment }); }
+      
+      template <typename U>
+      bool operator== (AlignedAllocator<U, Alignment> const&) const
+        { return true; }
+      template <typename U>
+      bool operator!= (AlignedAllocator<U, Alignment> const&) const
+        { return false; }
+    
+    }; // AlignedAllocator
+  
+  } // namespace details
+  
+  class PMTchannelTimingTable;
+  
+} // namespace sbn
+
+
+/**
+ * @brief Timing and threshold information of each PMT channel.
+ * 
+ * The information in this table is extracted from a `sbn::PMTconfiguration`
+ * once, and it can then be accessed by channel ID without further
+ * computation. It includes, for each channel:
+ * 
+ * * `preTriggerTicks()`, `postTriggerTicks()`: number of ticks in the
+ *   waveforms before and after the trigger, as in
+ *   `sbn::V1730Configuration::preTriggerTicks()` and `postTriggerTicks()`;
+ * * `preTriggerTime()`, `postTriggerTime()`: the same, in microseconds;
+ * * `enabled()`: whether the channel is enabled in the readout;
+ * * `relativeThreshold()`: the threshold relative to the baseline, as in
+ *   `sbn::V1730channelConfiguration::relativeThreshold()`.
+ * 
+ * The table has an entry for each channel ID from `0` to the largest one in
+ * the configuration, and channels with no configuration have all the values
+ * set to `0` and `hasChannel()` `false`. Should a channel be present more than
+ * once in the configuration, only its first appearance is used.
+ * 
+ * Each quantity is stored in its own array, aligned to a cache line, which
+ * can be accessed in full (e.g. `preTriggerTicksArray()`) to process all the
+ * channels at once.
+ * 
+ * Example:
+ * ~~~~{.cpp}
+ * sbn::PMTchannelTimingTable const timings { pmtConfig };
+ * for (raw::OpDetWaveform const& waveform: waveforms) {
+ *   if (!timings.hasChannel(waveform.ChannelNumber())) continue;
+ *   double const triggerTime = waveform.TimeStamp()
+ *     + timings.preTriggerTime(waveform.ChannelNumber());
+ *   // ...
+ * }
+ * ~~~~
+ */
+class sbn::PMTchannelTimingTable {
+  
+    public:
+  
+  /// Alignment of the arrays [bytes].
+  static constexpr std::size_t Alignment = 64U;
+  
+  /// Type of the array of each quantity.
+  template <typename T>
+  using Array_t = std::vector<T, details::AlignedAllocator<T, Alignment>>;
+  
+  
+  /// Constructor: an empty table.
+  PMTchannelTimingTable() = default;
+  
+  /// Constructor: fills the table with the information from `config`.
+  PMTchannelTimingTable(sbn::PMTconfiguration const& config);
+  
+  
+  // --- BEGIN -- Single channel access ----------------------------------------
+  /// @name Single channel access
+  /// @{
+  
+  /// Returns the number of entries (one more than the largest channel ID).
+  std::size_t size() const { return fPresent.size(); }
+  
+  /// Returns whether the table has no entry.
+  bool empty() const { return fPresent.empty(); }
+  
+  /// Returns whether the table has information for `channel`.
+  bool hasChannel(raw::Channel_t channel) const
+    { return (channel < size()) && fPresent[channel]; }
+  
+  /// Ticks in the waveform of `channel` before the trigger.
+  std::uint32_t preTriggerTicks(raw::Channel_t channel) const
+    { return fPreTriggerTicks[channel]; }
+  
+  /// Ticks in the waveform of `channel` after the trigger.
+  std::uint32_t postTriggerTicks(raw::Channel_t channel) const
+    { return fPostTriggerTicks[channel]; }
+  
+  /// Time in the waveform of `channel` before the trigger [us].
+  float preTriggerTime(raw::Channel_t channel) const
+    { return fPreTriggerTime[channel]; }
+  
+  /// Time in the waveform of `channel` after the trigger [us].
+  float postTriggerTime(raw::Channel_t channel) const
+    { return fPostTriggerTime[channel]; }
+  
+  /// Returns whether `channel` is enabled in the readout.
+  bool enabled(raw::Channel_t channel) const
+    { return fEnabled[channel] != 0U; }
+  
+  /// Threshold of `channel` relative to the baseline [ADC counts].
+  short signed int relativeThreshold(raw::Channel_t channel) const
+    { return fRelativeThreshold[channel]; }
+  
+  /// @}
+  // --- END ---- Single channel access ----------------------------------------
+  
+  
+  // --- BEGIN -- Array access -------------------------------------------------
+  /// @name Array access
+  /// @{
+  
+  // all arrays have `size()` entries, indexed by channel ID
+  
+  /// Whether each channel is in the table (`0` or `1`).
+  Array_t<std::uint8_t> const& presentArray() const { return fPresent; }
+  
+  /// Ticks before the trigger for each channel.
+  Array_t<std::uint32_t> const& preTriggerTicksArray() const
+    { return fPreTriggerTicks; }
+  
+  /// Ticks after the trigger for each channel.
+  Array_t<std::uint32_t> const& postTriggerTicksArray() const
+    { return fPostTriggerTicks; }
+  
+  /// Time before the trigger for each channel [us].
+  Array_t<float> const& preTriggerTimeArray() const
+    { return fPreTriggerTime; }
+  
+  /// Time after the trigger for each channel [us].
+  Array_t<float> const& postTriggerTimeArray() const
+    { return fPostTriggerTime; }
+  
+  /// Whether each channel is enabled (`0` or `1`).
+  Array_t<std::uint8_t> const& enabledArray() const { return fEnabled; }
+  
+  /// Threshold relative to the baseline for each channel [ADC counts].
+  Array_t<short signed int> const& relativeThresholdArray() const
+    { return fRelativeThreshold; }
+  
+  /// @}
+  // --- END ---- Array access -------------------------------------------------
+  
+  
+    private:
+  
+  Array_t<std::uint8_t> fPresent; ///< Whether each channel is configured.
+  Array_t<std::uint32_t> fPreTriggerTicks; ///< Pre-trigger ticks.
+  Array_t<std::uint32_t> fPostTriggerTicks; ///< Post-trigger ticks.
+  Array_t<float> fPreTriggerTime; ///< Pre-trigger time [us].
+  Array_t<float> fPostTriggerTime; ///< Post-trigger time [us].
+  Array_t<std::uint8_t> fEnabled; ///< Whether each channel is enabled.
+  Array_t<short signed int> fRelativeThreshold; ///< Relative threshold.
+  
+  /// Resizes all the arrays to `n` entries.
+  void resize(std::size_t n);
+  
+}; // sbn::PMTchannelTimingTable
+
+
+//------------------------------------------------------------------------------
+
+#endif // SBNOBJ_COMMON_PMT_DATA_PMTCHANNELTIMINGTABLE_H
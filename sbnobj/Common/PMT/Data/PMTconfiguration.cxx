@@ -10,14 +10,19 @@
 // library header
 #include "sbnobj/Common/PMT/Data/PMTconfiguration.h"
 
+// SBN libraries
+#include "sbnobj/Common/PMT/Data/ConfigurationHash.h"
+
 // C/C++ standard libraries
 #include <ostream>
+#include <cstdint> // std::uint64_t
 #include <cassert>
 
 
 //------------------------------------------------------------------------------
 static_assert(sbn::PMTconfiguration::DefaultDumpVerbosity <= sbn::PMTconfiguration::MaxDumpVerbosity);
 
+
 //------------------------------------------------------------------------------
 void sbn::PMTconfiguration::dump(std::ostream& out,
   std::string const& indent, std::string const& firstIndent,
@@ -76,4 +81,14 @@ void sbn::PMTconfiguration::dump(std::ostream& out,
 } // sbn::PMTconfiguration::dump()
 
 
+//------------------------------------------------------------------------------
+std::uint64_t sbn::PMTconfiguration::contentHash() const {
+  details::ConfigurationHasher hasher;
+  hasher.add(boards.size());
+  for (sbn::V1730Configuration const& board: boards)
+    hasher.add(board.contentHash());
+  return hasher.value();
+} // sbn::PMTconfiguration::contentHash()
+
+
 //------------------------------------------------------------------------------
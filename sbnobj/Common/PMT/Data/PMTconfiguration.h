@@ -14,6 +14,7 @@
 
 // C/C++ standard libraries
 #include <iosfwd> // std::ostream
+#include <cstdint> // std::uint64_t
 #include <string>
 #include <vector>
 
@@ -41,18 +42,37 @@ namespace sbn {
  * The class is default-constructible only, and its content needs to be added
  * element by element.
  * 
+ * 
+ * To look up channels and boards without scanning all the boards, see
+ * `sbn::PMTconfigurationIndex`.
+ * 
  */
 struct sbn::PMTconfiguration {
   
   // --- BEGIN -- Data members -------------------------------------------------
   
   // NOTE when adding data members, remember to add an element to the comparison
+  //      and to the content hash (`contentHash()`)
   
   /// Configuration of all PMT readout boards.
   std::vector<sbn::V1730Configuration> boards;
   
   // --- END ---- Data members -------------------------------------------------
   
+  
+  /**
+   * @brief Returns a 64-bit hash of the content of this configuration.
+   * 
+   * Equal configurations have the same hash; the hash does not depend on the
+   * platform nor on the process, and can be stored.
+   * Different configurations are very likely to have different hashes.
+   * 
+   * The hash is computed anew on each call: to avoid repeated comparisons of
+   * the same configurations, see `sbn::PMTconfigurationRegistry`.
+   */
+  std::uint64_t contentHash() const;
+  
+  
 #if __cplusplus < 202004L
   //@{
   /// Comparison: all fields need to have the same values.
@@ -138,6 +158,8 @@ struct sbn::PMTconfiguration {
 inline bool sbn::PMTconfiguration::operator==
   (sbn::PMTconfiguration const& other) const
 {
+  if (this == &other) return true; // e.g. the same interned configuration
+  
   
   if (boards != other.boards) return false;
   
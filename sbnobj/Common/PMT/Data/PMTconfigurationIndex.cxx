@@ -0,0 +1,97 @@
+/**
+ * @file   sbnobj/Common/PMT/Data/PMTconfigurationIndex.cxx
+ * @brief  Lookup of channels and boards in a PMT readout configuration.
+ * @see    sbnobj/Common/PMT/Data/PMTconfigurationIndex.h
+ */
+
+
+// library header
+#include "sbnobj/Common/PMT/Data/PMTconfigurationIndex.h"
+
+
+//------------------------------------------------------------------------------
+sbn::PMTconfigurationIndex::PMTconfigurationIndex
+  (sbn::PMTconfiguration const& config)
+  : fConfig{ &config }
+  , fChannels{ channelEntries(config.boards), ChannelLocation_t{} }
+  , fFragments{ fragmentEntries(config.boards), NoLocation }
+{}
+
+
+//------------------------------------------------------------------------------
+sbn::V1730channelConfiguration const* sbn::PMTconfigurationIndex::findChannel
+  (raw::Channel_t channel) const
+{
+  auto const location = fChannels[channel];
+  return location.isValid()
+    ? &(fConfig->boards[location.board].channels[location.channel]): nullptr;
+} // sbn::PMTconfigurationIndex::findChannel()
+
+
+//------------------------------------------------------------------------------
+sbn::V1730Configuration const* sbn::PMTconfigurationIndex::findBoardFor
+  (raw::Channel_t channel) const
+{
+  std::size_t const iBoard = findBoardIndexFor(channel);
+  return (iBoard == NoIndex)? nullptr: &(fConfig->boards[iBoard]);
+} // sbn::PMTconfigurationIndex::findBoardFor()
+
+
+//------------------------------------------------------------------------------
+std::size_t sbn::PMTconfigurationIndex::findBoardIndexFor
+  (raw::Channel_t channel) const
+{
+  auto const location = fChannels[channel];
+  return location.isValid()? location.board: NoIndex;
+} // sbn::PMTconfigurationIndex::findBoardIndexFor()
+
+
+//------------------------------------------------------------------------------
+sbn::V1730Configuration const*
+sbn::PMTconfigurationIndex::findBoardByFragment(unsigned int fragmentID) const
+{
+  std::uint32_t const iBoard = fFragments[fragmentID];
+  return (iBoard == NoLocation)? nullptr: &(fConfig->boards[iBoard]);
+} // sbn::PMTconfigurationIndex::findBoardByFragment()
+
+
+//------------------------------------------------------------------------------
+auto sbn::PMTconfigurationIndex::channelEntries
+  (std::vector<sbn::V1730Configuration> const& boards)
+  -> std::vector<std::pair<raw::Channel_t, ChannelLocation_t>>
+{
+  std::vector<std::pair<raw::Channel_t, ChannelLocation_t>> entries;
+  std::size_t nChannels = 0U;
+  for (sbn::V1730Configuration const& board: boards)
+    nChannels += board.channels.size();
+  entries.reserve(nChannels);
+  
+  for (std::size_t iBoard = 0U; iBoard < boards.size(); ++iBoard) {
+    auto const& channels = boards[iBoard].channels;
+    for (std::size_t iChannel = 0U; iChannel < channels.size(); ++iChannel) {
+      if (!channels[iChannel].hasChannelID()) continue;
+      entries.emplace_back(channels[iChannel].channelID, ChannelLocation_t{
+        static_cast<std::uint32_t>(iBoard), static_cast<std::uint32_t>(iChannel)
+        });
+    } // for channels
+  } // for boards
+  return entries;
+} // sbn::PMTconfigurationIndex::channelEntries()
+
+
+//------------------------------------------------------------------------------
+auto sbn::PMTconfigurationIndex::fragmentEntries
+  (std::vector<sbn::V1730Configuration> const& boards)
+  -> std::vector<std::pair<unsigned int, std::uint32_t>>
+{
+  std::vector<std::pair<unsigned int, std::uint32_t>> entries;
+  entries.reserve(boards.size());
+  for (std::size_t iBoard = 0U; iBoard < boards.size(); ++iBoard) {
+    entries.emplace_back
+      (boards[iBoard].fragmentID, static_cast<std::uint32_t>(iBoard));
+  }
+  return entries;
+} // sbn::PMTconfigurationIndex::fragmentEntries()
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,198 @@
+/**
+ * @file   sbnobj/Common/PMT/Data/PMTconfigurationIndex.h
+ * @brief  Lookup of channels and boards in a PMT readout configuration.
+ * @see    sbnobj/Common/PMT/Data/PMTconfigurationIndex.cxx
+ */
+
+#ifndef SBNOBJ_COMMON_PMT_DATA_PMTCONFIGURATIONINDEX_H
+#define SBNOBJ_COMMON_PMT_DATA_PMTCONFIGURATIONINDEX_H
+
+// SBN libraries
+#include "sbnobj/Common/PMT/Data/PMTconfiguration.h"
+#include "sbnobj/Common/PMT/Data/V1730Configuration.h"
+
+// LArSoft libraries
+#include "lardataobj/RawData/OpDetWaveform.h" // raw::Channel_t
+
+// C/C++ standard libraries
+#include <unordered_map>
+#include <algorithm> // std::minmax_element(), std::max()
+#include <vector>
+#include <utility> // std::pair
+#include <limits> // std::numeric_limits<>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+
+
+//------------------------------------------------------------------------------
+namespace sbn {
+  
+  class PMTconfigurationIndex;
+  
+  namespace details {
+    
+    /// Map from integral keys into values: direct lookup for dense keys, hash
+    /// table otherwise.
+    template <typename Key, typename Value>
+    class DenseOrHashTable {
+      
+      std::vector<Value> fDirect; ///< Direct lookup table, from `fMinKey`.
+      Key fMinKey {}; ///< Key of the first element of `fDirect`.
+      std::unordered_map<Key, Value> fHash; ///< Table used for sparse keys.
+      bool fUseDirect = true; ///< Whether the direct lookup table is in use.
+      Value fNotFound; ///< Value returned when the key is not present.
+  
+        public:
+      
+      /// Builds the table from `(key, value)` pairs; the first of each key wins.
+      DenseOrHashTable
+        (std::vector<std::pair<Key, Value>> const& entries, Value notFound);
+      
+      /// Returns the value for `key`, or the "not found" value.
+      Value operator[] (Key key) const;
+    
+    }; // DenseOrHashTable
+  
+  } // namespace details
+  
+} // namespace sbn
+
+
+//------------------------------------------------------------------------------
+/**
+ * @brief Lookup index of channels and boards of a `sbn::PMTconfiguration`.
+ * 
+ * The configuration of a channel can be looked up by its channel ID
+ * (`findChannel()`), and the configuration of a board by its fragment ID
+ * (`findBoardByFragment()`), without scanning all the boards.
+ * 
+ * The index is built from a configuration and it refers to it: the
+ * configuration must outlive the index, and any change of the configuration
+ * makes the index invalid. In that case, a new index needs to be built.
+ * The index is not modified by the lookups and can be shared among threads.
+ * 
+ * Example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * sbn::PMTconfiguration const& config = ...;
+ * sbn::PMTconfigurationIndex const configIndex { config };
+ * 
+ * sbn::V1730channelConfiguration const* channelConfig
+ *   = configIndex.findChannel(channel);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class sbn::PMTconfigurationIndex {
+  
+    public:
+  
+  /// Value returned for an index not found.
+  static constexpr std::size_t NoIndex
+    = std::numeric_limits<std::size_t>::max();
+  
+  /// Builds the index of the specified configuration.
+  explicit PMTconfigurationIndex(sbn::PMTconfiguration const& config);
+  
+  
+  /// Returns the configuration of the specified `channel` (`nullptr` if none).
+  sbn::V1730channelConfiguration const* findChannel
+    (raw::Channel_t channel) const;
+  
+  /// Returns the configuration of the board with `channel` (`nullptr` if none).
+  sbn::V1730Configuration const* findBoardFor(raw::Channel_t channel) const;
+  
+  /// Returns the index in `boards` of the board with `channel`, or `NoIndex`.
+  std::size_t findBoardIndexFor(raw::Channel_t channel) const;
+  
+  /// Returns the configuration of the board with the specified fragment ID
+  /// (`nullptr` if none).
+  sbn::V1730Configuration const* findBoardByFragment
+    (unsigned int fragmentID) const;
+  
+  /// Returns the indexed configuration.
+  sbn::PMTconfiguration const& configuration() const { return *fConfig; }
+  
+  
+    private:
+  
+  /// Location of a channel: indices of board and of channel in the board.
+  struct ChannelLocation_t {
+    std::uint32_t board = NoLocation;
+    std::uint32_t channel = NoLocation;
+    
+    bool isValid() const { return board != NoLocation; }
+    bool operator== (ChannelLocation_t const& other) const
+      { return (board == other.board) && (channel == other.channel); }
+  }; // ChannelLocation_t
+  
+  /// Value of a location not found.
+  static constexpr std::uint32_t NoLocation
+    = std::numeric_limits<std::uint32_t>::max();
+  
+  sbn::PMTconfiguration const* fConfig; ///< The indexed configuration.
+  
+  /// Channel ID to location of the channel configuration.
+  details::DenseOrHashTable<raw::Channel_t, ChannelLocation_t> fChannels;
+  
+  /// Fragment ID to board index.
+  details::DenseOrHashTable<unsigned int, std::uint32_t> fFragments;
+  
+  
+  /// Returns the location of all the channels with an ID in `boards`.
+  static std::vector<std::pair<raw::Channel_t, ChannelLocation_t>>
+  channelEntries(std::vector<sbn::V1730Configuration> const& boards);
+  
+  /// Returns the board index of each fragment ID in `boards`.
+  static std::vector<std::pair<unsigned int, std::uint32_t>>
+  fragmentEntries(std::vector<sbn::V1730Configuration> const& boards);
+  
+}; // sbn::PMTconfigurationIndex
+
+
+//------------------------------------------------------------------------------
+//---  Template implementation
+//------------------------------------------------------------------------------
+template <typename Key, typename Value>
+sbn::details::DenseOrHashTable<Key, Value>::DenseOrHashTable
+  (std::vector<std::pair<Key, Value>> const& entries, Value notFound)
+  : fNotFound{ notFound }
+{
+  if (entries.empty()) return;
+  
+  auto const [ itMin, itMax ] = std::minmax_element(
+    entries.begin(), entries.end(),
+    [](auto const& a, auto const& b){ return a.first < b.first; }
+    );
+  std::size_t const span = static_cast<std::size_t>(itMax->first)
+    - static_cast<std::size_t>(itMin->first) + 1U;
+  
+  // a direct table is used unless most of it would be empty
+  fUseDirect = span <= std::max<std::size_t>(2U * entries.size(), 1024U);
+  if (fUseDirect) {
+    fMinKey = itMin->first;
+    fDirect.assign(span, fNotFound);
+    for (auto const& [ key, value ]: entries) {
+      Value& slot = fDirect[key - fMinKey];
+      if (slot == fNotFound) slot = value;
+    }
+  }
+  else {
+    fHash.reserve(entries.size());
+    for (auto const& [ key, value ]: entries) fHash.emplace(key, value);
+  }
+} // sbn::details::DenseOrHashTable<>::DenseOrHashTable()
+
+
+//------------------------------------------------------------------------------
+template <typename Key, typename Value>
+Value sbn::details::DenseOrHashTable<Key, Value>::operator[] (Key key) const {
+  if (fUseDirect) {
+    return ((key < fMinKey) || (key - fMinKey >= fDirect.size()))
+      ? fNotFound: fDirect[key - fMinKey];
+  }
+  auto const it = fHash.find(key);
+  return (it == fHash.end())? fNotFound: it->second;
+} // sbn::details::DenseOrHashTable<>::operator[]()
+
+
+//------------------------------------------------------------------------------
+
+#endif // SBNOBJ_COMMON_PMT_DATA_PMTCONFIGURATIONINDEX_H
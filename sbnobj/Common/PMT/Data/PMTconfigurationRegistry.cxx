@@ -0,0 +1,75 @@
+/**
+ * @file   sbnobj/Common/PMT/Data/PMTconfigurationRegistry.cxx
+ * @brief  Registry sharing identical PMT readout configurations.
+ * @see    sbnobj/Common/PMT/Data/PMTconfigurationRegistry.h
+ */
+
+// library header
+#include "sbnobj/Common/PMT/Data/PMTconfigurationRegistry.h"
+
+// C/C++ standard libraries
+#include <utility> // std::move()
+
+
+//------------------------------------------------------------------------------
+auto sbn::PMTconfigurationRegistry::intern(sbn::PMTconfiguration config)
+  -> ConfigPtr_t
+{
+  std::uint64_t const hash = config.contentHash(); // computed outside the lock
+  
+  std::lock_guard const lock { fMutex };
+  ++fNRequests;
+  if (ConfigPtr_t registered = findWithHash(config, hash)) return registered;
+  
+  auto newConfig
+    = std::make_shared<sbn::PMTconfiguration const>(std::move(config));
+  fConfigs.emplace(hash, newConfig);
+  return newConfig;
+} // sbn::PMTconfigurationRegistry::intern()
+
+
+//------------------------------------------------------------------------------
+auto sbn::PMTconfigurationRegistry::find
+  (sbn::PMTconfiguration const& config) const -> ConfigPtr_t
+{
+  std::uint64_t const hash = config.contentHash();
+  std::lock_guard const lock { fMutex };
+  return findWithHash(config, hash);
+} // sbn::PMTconfigurationRegistry::find()
+
+
+//------------------------------------------------------------------------------
+std::size_t sbn::PMTconfigurationRegistry::size() const {
+  std::lock_guard const lock { fMutex };
+  return fConfigs.size();
+} // sbn::PMTconfigurationRegistry::size()
+
+
+//------------------------------------------------------------------------------
+std::size_t sbn::PMTconfigurationRegistry::nRequests() const {
+  std::lock_guard const lock { fMutex };
+  return fNRequests;
+} // sbn::PMTconfigurationRegistry::nRequests()
+
+
+//------------------------------------------------------------------------------
+void sbn::PMTconfigurationRegistry::clear() {
+  std::lock_guard const lock { fMutex };
+  fConfigs.clear();
+} // sbn::PMTconfigurationRegistry::clear()
+
+
+//------------------------------------------------------------------------------
+auto sbn::PMTconfigurationRegistry::findWithHash
+  (sbn::PMTconfiguration const& config, std::uint64_t hash) const
+  -> ConfigPtr_t
+{
+  // the full comparison protects against (unlikely) hash collisions
+  auto const [ begin, end ] = fConfigs.equal_range(hash);
+  for (auto it = begin; it != end; ++it)
+    if (*(it->second) == config) return it->second;
+  return {};
+} // sbn::PMTconfigurationRegistry::findWithHash()
+
+
+//------------------------------------------------------------------------------
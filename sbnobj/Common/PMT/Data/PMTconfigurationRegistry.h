@@ -0,0 +1,103 @@
+/**
+ * @file   sbnobj/Common/PMT/Data/PMTconfigurationRegistry.h
+ * @brief  Registry sharing identical PMT readout configurations.
+ * @see    sbnobj/Common/PMT/Data/PMTconfigurationRegistry.cxx
+ */
+ 
+#ifndef SBNOBJ_COMMON_PMT_DATA_PMTCONFIGURATIONREGISTRY_H
+#define SBNOBJ_COMMON_PMT_DATA_PMTCONFIGURATIONREGISTRY_H
+
+// SBN libraries
+#include "sbnobj/Common/PMT/Data/PMTconfiguration.h"
+
+// C/C++ standard libraries
+#include <unordered_map>
+#include <memory> // std::shared_ptr
+#include <mutex>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+
+
+//------------------------------------------------------------------------------
+namespace sbn { class PMTconfigurationRegistry; }
+
+/**
+ * @brief Keeps a single copy of each distinct PMT readout configuration.
+ * 
+ * The configuration of the PMT readout is usually the same for many runs.
+ * This registry keeps a single, shared copy of each distinct configuration
+ * (_interning_): all the configurations registered with the same content
+ * are represented by the same object.
+ * Two interned configurations are then equal if and only if they are the same
+ * object, and comparing them does not require comparing their content:
+ * ~~~~{.cpp}
+ * sbn::PMTconfigurationRegistry registry;
+ * 
+ * auto const config
+ *   = registry.intern(run.getProduct<sbn::PMTconfiguration>(tag));
+ * if (config != lastConfig) { // pointer comparison
+ *   // ... configuration has changed
+ *   lastConfig = config;
+ * }
+ * ~~~~
+ * 
+ * Each configuration is looked up by its content hash
+ * (`sbn::PMTconfiguration::contentHash()`), and its content is compared only
+ * with the registered configurations with the same hash.
+ * 
+ * The registered configurations are kept until the registry is cleared or
+ * destroyed; the configurations already handed out stay valid after that.
+ * 
+ * All the public methods can be called concurrently.
+ */
+class sbn::PMTconfigurationRegistry {
+  
+    public:
+  
+  /// Type of pointer to a registered configuration.
+  using ConfigPtr_t = std::shared_ptr<sbn::PMTconfiguration const>;
+  
+  /**
+   * @brief Returns the registered configuration equal to `config`.
+   * @param config the configuration to be interned
+   * @return a pointer to the registered configuration with the same content
+   * 
+   * If no configuration with the same content is registered yet, `config` is
+   * registered (moved into the registry).
+   */
+  ConfigPtr_t intern(sbn::PMTconfiguration config);
+  
+  /// Returns the registered configuration equal to `config`, if any
+  /// (`nullptr` otherwise).
+  ConfigPtr_t find(sbn::PMTconfiguration const& config) const;
+  
+  /// Returns the number of distinct configurations registered.
+  std::size_t size() const;
+  
+  /// Returns the number of configurations interned so far.
+  std::size_t nRequests() const;
+  
+  /// Removes all the configurations from the registry.
+  void clear();
+  
+  
+    private:
+  
+  /// Registered configurations, by content hash.
+  std::unordered_multimap<std::uint64_t, ConfigPtr_t> fConfigs;
+  
+  std::size_t fNRequests = 0U; ///< Number of calls to `intern()`.
+  
+  mutable std::mutex fMutex; ///< Protects the content of the registry.
+  
+  /// Returns the registered configuration equal to `config` with `hash`.
+  /// The caller must hold the lock.
+  ConfigPtr_t findWithHash
+    (sbn::PMTconfiguration const& config, std::uint64_t hash) const;
+  
+}; // sbn::PMTconfigurationRegistry
+
+
+//------------------------------------------------------------------------------
+
+#endif // SBNOBJ_COMMON_PMT_DATA_PMTCONFIGURATIONREGISTRY_H
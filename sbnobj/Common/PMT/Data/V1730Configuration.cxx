@@ -9,6 +9,9 @@
 // library header
 #include "sbnobj/Common/PMT/Data/V1730Configuration.h"
 
+// SBN libraries
+#include "sbnobj/Common/PMT/Data/ConfigurationHash.h"
+
 // C/C++ standard libraries
 #include <ostream>
 #include <cassert>
@@ -83,4 +86,23 @@ void sbn::V1730Configuration::dump(std::ostream& out,
 } // sbn::V1730Configuration::dump()
 
 
+//------------------------------------------------------------------------------
+std::uint64_t sbn::V1730Configuration::contentHash() const {
+  details::ConfigurationHasher hasher;
+  hasher
+    .add(boardName)
+    .add(boardID)
+    .add(fragmentID)
+    .add(bufferLength)
+    .add(postTriggerFrac)
+    .add(useTimeTagForTimeStamp)
+    .add(nChannels)
+    .add(channels.size())
+    ;
+  for (sbn::V1730channelConfiguration const& channel: channels)
+    hasher.add(channel.contentHash());
+  return hasher.value();
+} // sbn::V1730Configuration::contentHash()
+
+
 //------------------------------------------------------------------------------
@@ -16,6 +16,7 @@
 #include <iosfwd> // std::ostream
 #include <vector>
 #include <string>
+#include <cstdint> // std::uint64_t
 
 
 //------------------------------------------------------------------------------
@@ -47,6 +48,7 @@ struct sbn::V1730Configuration {
   // --- BEGIN -- Data members -------------------------------------------------
   
   // NOTE when adding data members, remember to add an element to the comparison
+  //      and to the content hash (`contentHash()`)
   
   /// Name (mnemonic) of the board.
   std::string boardName;
@@ -97,6 +99,16 @@ struct sbn::V1730Configuration {
   // --- END ---- Derived quantities -------------------------------------------
   
   
+  /**
+   * @brief Returns a 64-bit hash of the content of this configuration.
+   * 
+   * Equal configurations have the same hash; the hash does not depend on the
+   * platform nor on the process, and can be stored.
+   * Different configurations are very likely to have different hashes.
+   */
+  std::uint64_t contentHash() const;
+  
+  
 #if __cplusplus < 202004L
   //@{
   /// Comparison: all fields need to have the same values.
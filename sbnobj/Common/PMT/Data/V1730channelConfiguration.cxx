@@ -9,6 +9,9 @@
 // library header
 #include "sbnobj/Common/PMT/Data/V1730channelConfiguration.h"
 
+// SBN libraries
+#include "sbnobj/Common/PMT/Data/ConfigurationHash.h"
+
 // C/C++ standard libraries
 #include <ostream>
 #include <cassert>
@@ -59,4 +62,16 @@ void sbn::V1730channelConfiguration::dump(std::ostream& out,
 } // sbn::V1730channelConfiguration::dump()
 
 
+//------------------------------------------------------------------------------
+std::uint64_t sbn::V1730channelConfiguration::contentHash() const {
+  return details::ConfigurationHasher{}
+    .add(channelNo)
+    .add(channelID)
+    .add(baseline)
+    .add(threshold)
+    .add(enabled)
+    .value();
+} // sbn::V1730channelConfiguration::contentHash()
+
+
 //------------------------------------------------------------------------------
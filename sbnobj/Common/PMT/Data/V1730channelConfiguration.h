@@ -16,6 +16,7 @@
 #include <iosfwd> // std::ostream
 #include <string>
 #include <limits>
+#include <cstdint> // std::uint64_t
 
 
 //------------------------------------------------------------------------------
@@ -51,6 +52,7 @@ struct sbn::V1730channelConfiguration {
   // --- BEGIN -- Data members -------------------------------------------------
   
   // NOTE when adding data members, remember to add an element to the comparison
+  //      and to the content hash (`contentHash()`)
   
   /// Number of the channel on the board (0-15).
   short unsigned int channelNo = std::numeric_limits<short unsigned int>::max();
@@ -81,6 +83,16 @@ struct sbn::V1730channelConfiguration {
   // --- END ---- Derived quantities -------------------------------------------
   
   
+  /**
+   * @brief Returns a 64-bit hash of the content of this configuration.
+   * 
+   * Equal configurations have the same hash; the hash does not depend on the
+   * platform nor on the process, and can be stored.
+   * Different configurations are very likely to have different hashes.
+   */
+  std::uint64_t contentHash() const;
+  
+  
 #if __cplusplus < 202004L
   //@{
   /// Comparison: all fields need to have the same values.
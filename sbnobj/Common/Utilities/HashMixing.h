@@ -0,0 +1,41 @@
+/**
+ * @file   sbnobj/Common/Utilities/HashMixing.h
+ * @brief  Function folding values into a 64-bit hash.
+ * 
+ * This is a header-only library.
+ */
+
+#ifndef SBNOBJ_COMMON_UTILITIES_HASHMIXING_H
+#define SBNOBJ_COMMON_UTILITIES_HASHMIXING_H
+
+// C/C++ standard libraries
+#include <cstdint> // std::uint64_t
+
+
+//------------------------------------------------------------------------------
+namespace sbn::details {
+  
+  /**
+   * @brief Returns `hash` with `value` folded in.
+   * @param hash the current value of the hash
+   * @param value the value to be added to the hash
+   * @return the new value of the hash
+   * 
+   * The value is combined with the hash as in `boost::hash_combine()`, and the
+   * result goes through the `splitmix64` finalizer.
+   * The result depends only on the sequence of the values, not on the platform
+   * or on the process, and it can be stored.
+   */
+  constexpr std::uint64_t mixHash(std::uint64_t hash, std::uint64_t value) {
+    hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+    return hash ^ (hash >> 31);
+  } // mixHash()
+  
+} // namespace sbn::details
+
+
+//------------------------------------------------------------------------------
+
+#endif // SBNOBJ_COMMON_UTILITIES_HASHMIXING_H
@@ -0,0 +1,135 @@
+#include "sbnobj/ICARUS/CRT/CRTDataKernels.hh"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+  void checkChannels(std::size_t nChannels) {
+    if ((nChannels == 0) || (nChannels > icarus::crt::CRTDataNChannels)) {
+      throw std::runtime_error("icarus::crt::CRTDataKernels: invalid number of channels ("
+        + std::to_string(nChannels) + "), must be between 1 and "
+        + std::to_string(icarus::crt::CRTDataNChannels));
+    }
+  }
+
+  void checkSignals(std::size_t nSignals, std::size_t nChannels) {
+    checkChannels(nChannels);
+    if (nSignals % nChannels != 0) {
+      throw std::runtime_error("icarus::crt::CRTDataKernels: " + std::to_string(nSignals)
+        + " signals are not a multiple of " + std::to_string(nChannels) + " channels");
+    }
+  }
+
+} // local namespace
+
+
+namespace icarus::crt {
+
+  CRTFEBCalibrationTable::CRTFEBCalibrationTable()
+    : fPedestals(256), fGains(256), fCalibrated(256, false)
+  {
+    for (ChannelValues_t& pedestals: fPedestals) pedestals.fill(0.0);
+    for (ChannelValues_t& gains: fGains) gains.fill(1.0);
+  }
+
+
+  void CRTFEBCalibrationTable::setPedestals(uint8_t mac5, ChannelValues_t const& pedestals) {
+    fPedestals[mac5] = pedestals;
+    fCalibrated[mac5] = true;
+  }
+
+
+  void CRTFEBCalibrationTable::setGains(uint8_t mac5, ChannelValues_t const& gains) {
+    fGains[mac5] = gains;
+    fCalibrated[mac5] = true;
+  }
+
+
+  std::vector<float> CRTDataKernels::subtractPedestals(std::vector<CRTData> const& data,
+    CRTFEBCalibrationTable const& calibration, std::size_t nChannels /* = CAENFEBNChannels */)
+  {
+    checkChannels(nChannels);
+    std::vector<float> signals(data.size() * nChannels);
+    float* out = signals.data();
+    for (CRTData const& hit: data) {
+      float const* pedestals = calibration.pedestals(hit.fMac5).data();
+      uint16_t const* adc = hit.fAdc;
+      for (std::size_t c = 0; c < nChannels; ++c) out[c] = adc[c] - pedestals[c];
+      out += nChannels;
+    }
+    return signals;
+  }
+
+
+  void CRTDataKernels::convertToPE(std::vector<float>& signals, std::vector<CRTData> const& data,
+    CRTFEBCalibrationTable const& calibration, std::size_t nChannels /* = CAENFEBNChannels */)
+  {
+    checkSignals(signals.size(), nChannels);
+    if (signals.size() != data.size() * nChannels) {
+      throw std::runtime_error("icarus::crt::CRTDataKernels::convertToPE(): "
+        + std::to_string(signals.size()) + " signals for " + std::to_string(data.size())
+        + " hits with " + std::to_string(nChannels) + " channels");
+    }
+    float* out = signals.data();
+    for (CRTData const& hit: data) {
+      float const* gains = calibration.gains(hit.fMac5).data();
+      for (std::size_t c = 0; c < nChannels; ++c) out[c] /= gains[c];
+      out += nChannels;
+    }
+  }
+
+
+  std::vector<float> CRTDataKernels::toPE(std::vector<CRTData> const& data,
+    CRTFEBCalibrationTable const& calibration, std::size_t nChannels /* = CAENFEBNChannels */)
+  {
+    std::vector<float> signals = subtractPedestals(data, calibration, nChannels);
+    convertToPE(signals, data, calibration, nChannels);
+    return signals;
+  }
+
+
+  std::vector<uint32_t> CRTDataKernels::pairCoincidences
+    (std::vector<float> const& signals, float threshold, std::size_t nChannels /* = CAENFEBNChannels */)
+  {
+    checkSignals(signals.size(), nChannels);
+    std::size_t const nHits = signals.size() / nChannels;
+    std::size_t const nPairs = nChannels / 2;
+
+    std::vector<uint32_t> masks(nHits);
+    float const* in = signals.data();
+    for (std::size_t i = 0; i < nHits; ++i, in += nChannels) {
+      uint32_t mask = 0;
+      for (std::size_t k = 0; k < nPairs; ++k) {
+        uint32_t const both = (in[2 * k] > threshold) & (in[2 * k + 1] > threshold);
+        mask |= both << k;
+      }
+      masks[i] = mask;
+    }
+    return masks;
+  }
+
+
+  auto CRTDataKernels::maxChannels
+    (std::vector<float> const& signals, std::size_t nChannels /* = CAENFEBNChannels */)
+    -> std::vector<MaxChannel_t>
+  {
+    checkSignals(signals.size(), nChannels);
+    std::size_t const nHits = signals.size() / nChannels;
+
+    std::vector<MaxChannel_t> maxima(nHits);
+    float const* in = signals.data();
+    for (std::size_t i = 0; i < nHits; ++i, in += nChannels) {
+      // a NaN signal is never the maximum, unless all the signals are NaN
+      std::size_t maxChannel = 0;
+      for (std::size_t c = 1; c < nChannels; ++c) {
+        if ((in[c] > in[maxChannel]) || (std::isnan(in[maxChannel]) && !std::isnan(in[c])))
+          maxChannel = c;
+      }
+      maxima[i] = { static_cast<uint8_t>(maxChannel), in[maxChannel] };
+    }
+    return maxima;
+  }
+
+} // namespace icarus::crt
@@ -0,0 +1,104 @@
+#ifndef ICCRTDataKernels_hh_
+#define ICCRTDataKernels_hh_
+
+#include "sbnobj/ICARUS/CRT/CRTData.hh"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace icarus::crt {
+
+  /// Number of ADC channels in `CRTData::fAdc`.
+  static constexpr std::size_t CRTDataNChannels = sizeof(CRTData::fAdc) / sizeof(CRTData::fAdc[0]);
+
+  /// Number of channels used by CAEN (Bern) CRT FEBs.
+  static constexpr std::size_t CAENFEBNChannels = 32;
+
+  /**
+   * @brief Per-FEB calibration of the CRT channels: pedestal and gain
+   *
+   * The FEBs are identified by their `CRTData::fMac5` address.
+   * Channels of FEBs without calibration have pedestal `0` and gain `1`.
+   */
+  class CRTFEBCalibrationTable {
+
+  public:
+
+    using ChannelValues_t = std::array<float, CRTDataNChannels>;
+
+    CRTFEBCalibrationTable();
+
+    /// Sets the pedestals [ADC] of all the channels of FEB `mac5`.
+    void setPedestals(uint8_t mac5, ChannelValues_t const& pedestals);
+
+    /// Sets the gains [ADC/PE] of all the channels of FEB `mac5`.
+    void setGains(uint8_t mac5, ChannelValues_t const& gains);
+
+    ChannelValues_t const& pedestals(uint8_t mac5) const { return fPedestals[mac5]; }
+    ChannelValues_t const& gains(uint8_t mac5) const { return fGains[mac5]; }
+
+    /// Returns whether pedestals or gains have been set for FEB `mac5`.
+    bool hasFEB(uint8_t mac5) const { return fCalibrated[mac5]; }
+
+  private:
+
+    std::vector<ChannelValues_t> fPedestals; ///< Pedestals by FEB address.
+    std::vector<ChannelValues_t> fGains; ///< Gains by FEB address.
+    std::vector<bool> fCalibrated; ///< Whether each FEB has a calibration.
+
+  };
+
+
+  /**
+   * @brief Processing of the ADC of a collection of `CRTData`, all at once
+   *
+   * Signals are returned in a single array with `nChannels` values per hit:
+   * the value of channel `c` of the hit `i` of the collection is at index
+   * `i * nChannels + c`. Only the first `nChannels` ADC of each hit are used
+   * (`CAENFEBNChannels` by default).
+   *
+   * The loops are written to be vectorized by the compiler; no instruction set
+   * specific code is used.
+   */
+  namespace CRTDataKernels {
+
+    /// Returns the ADC of the `data` minus the pedestal of their FEB and channel.
+    std::vector<float> subtractPedestals(std::vector<CRTData> const& data,
+      CRTFEBCalibrationTable const& calibration, std::size_t nChannels = CAENFEBNChannels);
+
+    /// Converts in place pedestal-subtracted `signals` of the `data` into PE.
+    void convertToPE(std::vector<float>& signals, std::vector<CRTData> const& data,
+      CRTFEBCalibrationTable const& calibration, std::size_t nChannels = CAENFEBNChannels);
+
+    /// Returns the PE of each channel of the `data` (pedestal subtraction and gain).
+    std::vector<float> toPE(std::vector<CRTData> const& data,
+      CRTFEBCalibrationTable const& calibration, std::size_t nChannels = CAENFEBNChannels);
+
+    /**
+     * @brief Returns the channel pairs with both signals above `threshold`.
+     *
+     * The two channels `2k` and `2k + 1` read the same strip; bit `k` of the
+     * mask of a hit is set if both channels have a signal above `threshold`.
+     */
+    std::vector<uint32_t> pairCoincidences
+      (std::vector<float> const& signals, float threshold, std::size_t nChannels = CAENFEBNChannels);
+
+    /// Channel with the largest signal in a hit.
+    struct MaxChannel_t {
+      uint8_t channel = 0;
+      float signal = 0.0;
+    };
+
+    /// Returns the channel with the largest signal of each hit (the first one on ties).
+    /// NaN signals are ignored; if all the signals of a hit are NaN, channel 0 is returned.
+    std::vector<MaxChannel_t> maxChannels
+      (std::vector<float> const& signals, std::size_t nChannels = CAENFEBNChannels);
+
+  } // namespace CRTDataKernels
+
+} // namespace icarus::crt
+
+
+#endif
@@ -0,0 +1,62 @@
+#include "sbnobj/ICARUS/CRT/CRTFEBLiveTimeAccumulator.hh"
+
+namespace icarus::crt {
+
+  auto CRTFEBLiveTimeAccumulator::FEBStats_t::operator+=(FEBStats_t const& other) -> FEBStats_t& {
+    nHits += other.nHits;
+    nLostHits += other.nLostHits;
+    nPolls += other.nPolls;
+    nHitsInPolls += other.nHitsInPolls;
+    pollTime += other.pollTime;
+    deadTime += other.deadTime;
+    return *this;
+  }
+
+
+  void CRTFEBLiveTimeAccumulator::add(CRTData const& hit) {
+    FEBState_t& feb = fFEBs[hit.fMac5];
+    addTo(feb.event, feb.eventPoll, hit);
+    addTo(feb.run, feb.runPoll, hit);
+  }
+
+
+  void CRTFEBLiveTimeAccumulator::endEvent() {
+    for (FEBState_t& feb: fFEBs) {
+      feb.event = FEBStats_t{};
+      feb.eventPoll = PollState_t{};
+    }
+  }
+
+
+  void CRTFEBLiveTimeAccumulator::reset() {
+    fFEBs.fill(FEBState_t{});
+  }
+
+
+  std::vector<uint8_t> CRTFEBLiveTimeAccumulator::FEBs() const {
+    std::vector<uint8_t> febs;
+    for (std::size_t mac5 = 0; mac5 < fFEBs.size(); ++mac5)
+      if (fFEBs[mac5].run.nHits > 0) febs.push_back(mac5);
+    return febs;
+  }
+
+
+  void CRTFEBLiveTimeAccumulator::addTo(FEBStats_t& stats, PollState_t& poll, CRTData const& hit) {
+    ++stats.nHits;
+    stats.nLostHits += hit.fLostHits;
+    if ((hit.fLostHits > 0) && (hit.fLastAcceptedTimestamp > 0)
+      && (hit.fLastAcceptedTimestamp <= hit.fTs0))
+    {
+      stats.deadTime += hit.fTs0 - hit.fLastAcceptedTimestamp;
+    }
+
+    if (poll.started && (hit.fThisPollStart == poll.start)) return;
+    poll.start = hit.fThisPollStart;
+    poll.started = true;
+    ++stats.nPolls;
+    stats.nHitsInPolls += hit.fHitsInPoll;
+    if ((hit.fLastPollStart > 0) && (hit.fLastPollStart <= hit.fThisPollStart))
+      stats.pollTime += hit.fThisPollStart - hit.fLastPollStart;
+  }
+
+} // namespace icarus::crt
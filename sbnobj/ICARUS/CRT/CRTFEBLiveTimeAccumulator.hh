@@ -0,0 +1,102 @@
+#ifndef ICCRTFEBLiveTimeAccumulator_hh_
+#define ICCRTFEBLiveTimeAccumulator_hh_
+
+#include "sbnobj/ICARUS/CRT/CRTData.hh"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace icarus::crt {
+
+  /**
+   * @brief Accumulates live time and lost hits of each CRT FEB
+   *
+   * The poll bookkeeping of the `CRTData` is used:
+   *
+   *  * each data transfer ("poll") of a FEB is counted once, when the first
+   *    hit with its `fThisPollStart` is seen; its duration is the time from
+   *    the previous poll (`fThisPollStart - fLastPollStart`), and its total
+   *    number of hits is `fHitsInPoll`;
+   *  * `fLostHits` hits were omitted by the FEB between `fLastAcceptedTimestamp`
+   *    and the hit, and that interval is counted as dead time (an upper limit,
+   *    since the FEB may have been live for part of it).
+   *
+   * The hits of each FEB must be added in the order they were recorded
+   * (`fEntry`). Statistics are kept for the current event and for the whole
+   * run; `endEvent()` starts a new event. The memory used is fixed, with a
+   * small state for each possible FEB address.
+   */
+  class CRTFEBLiveTimeAccumulator {
+
+  public:
+
+    /// Statistics of a FEB.
+    struct FEBStats_t {
+      std::size_t nHits = 0; ///< Number of hits recorded.
+      std::size_t nLostHits = 0; ///< Number of hits omitted by the FEB.
+      std::size_t nPolls = 0; ///< Number of data transfers.
+      std::size_t nHitsInPolls = 0; ///< Total hits in the data transfers (including omitted).
+      uint64_t pollTime = 0; ///< Total time covered by the data transfers [ns].
+      uint64_t deadTime = 0; ///< Total time with omitted hits [ns].
+
+      /// Returns the fraction of hits omitted by the FEB.
+      double lostFraction() const
+        { return (nHits + nLostHits == 0)? 0.0: double(nLostHits) / (nHits + nLostHits); }
+
+      /// Returns the time the FEB was live [ns].
+      uint64_t liveTime() const { return (pollTime > deadTime)? pollTime - deadTime: 0; }
+
+      /// Returns the fraction of time the FEB was live.
+      double liveFraction() const
+        { return (pollTime == 0)? 0.0: double(liveTime()) / pollTime; }
+
+      FEBStats_t& operator+=(FEBStats_t const& other);
+    };
+
+    /// Adds a hit to the statistics.
+    void add(CRTData const& hit);
+
+    /// Adds all the hits to the statistics.
+    void add(std::vector<CRTData> const& hits) { for (CRTData const& hit: hits) add(hit); }
+
+    /// Clears the statistics of the current event.
+    void endEvent();
+
+    /// Clears all the statistics.
+    void reset();
+
+    /// Returns the statistics of FEB `mac5` in the current event.
+    FEBStats_t const& eventStats(uint8_t mac5) const { return fFEBs[mac5].event; }
+
+    /// Returns the statistics of FEB `mac5` in the run.
+    FEBStats_t const& runStats(uint8_t mac5) const { return fFEBs[mac5].run; }
+
+    /// Returns the addresses of the FEBs with hits in the run, sorted.
+    std::vector<uint8_t> FEBs() const;
+
+  private:
+
+    /// Poll being accumulated.
+    struct PollState_t {
+      uint64_t start = 0; ///< `fThisPollStart` of the current poll.
+      bool started = false; ///< Whether any poll was seen.
+    };
+
+    struct FEBState_t {
+      FEBStats_t event, run;
+      PollState_t eventPoll, runPoll;
+    };
+
+    std::array<FEBState_t, 256> fFEBs;
+
+    /// Adds `hit` to the `stats`; `poll` tracks the data transfers.
+    static void addTo(FEBStats_t& stats, PollState_t& poll, CRTData const& hit);
+
+  };
+
+} // namespace icarus::crt
+
+
+#endif
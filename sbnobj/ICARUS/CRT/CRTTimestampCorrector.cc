@@ -0,0 +1,89 @@
+#include "sbnobj/ICARUS/CRT/CRTTimestampCorrector.hh"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace icarus::crt {
+
+  auto CRTTimestampCorrector::Stats_t::operator+=(Stats_t const& other) -> Stats_t& {
+    nHits += other.nHits;
+    nOverflowTS0 += other.nOverflowTS0;
+    nOverflowTS1 += other.nOverflowTS1;
+    nReferenceTS0 += other.nReferenceTS0;
+    nReferenceTS1 += other.nReferenceTS1;
+    return *this;
+  }
+
+
+  auto CRTTimestampCorrector::correct(std::vector<CRTData>& data) -> Stats_t {
+    // order of processing: by FEB, then by entry (counting sort on the address)
+    std::array<std::size_t, 257> start{};
+    for (CRTData const& hit: data) ++start[hit.fMac5 + 1];
+    std::partial_sum(start.begin(), start.end(), start.begin());
+
+    std::vector<std::size_t> order(data.size());
+    std::array<std::size_t, 256> next;
+    std::copy(start.begin(), start.end() - 1, next.begin());
+    for (std::size_t i = 0; i < data.size(); ++i) order[next[data[i].fMac5]++] = i;
+
+    Stats_t stats;
+    for (std::size_t feb = 0; feb < 256; ++feb) {
+      auto const first = order.begin() + start[feb], last = order.begin() + start[feb + 1];
+      auto const byEntry = [&data](std::size_t a, std::size_t b){ return data[a].fEntry < data[b].fEntry; };
+      if (!std::is_sorted(first, last, byEntry)) std::stable_sort(first, last, byEntry);
+      for (auto it = first; it != last; ++it) stats += correct(data[*it]);
+    }
+    return stats;
+  }
+
+
+  auto CRTTimestampCorrector::correct(CRTData& hit) -> Stats_t {
+    FEBState_t& feb = fFEBs[hit.fMac5];
+    Stats_t stats;
+    stats.nHits = 1;
+
+    auto const [ overflow0, reference0 ] = correctTime(hit.fTs0, feb.ts0,
+      hit.IsOverflow_TS0(), hit.IsReference_TS0(), fConfig.ts0CounterPeriod, fConfig.ts0ReferencePeriod);
+    auto const [ overflow1, reference1 ] = correctTime(hit.fTs1, feb.ts1,
+      hit.IsOverflow_TS1(), hit.IsReference_TS1(), fConfig.ts1CounterPeriod, fConfig.ts1ReferencePeriod);
+
+    stats.nOverflowTS0 = overflow0;
+    stats.nReferenceTS0 = reference0;
+    stats.nOverflowTS1 = overflow1;
+    stats.nReferenceTS1 = reference1;
+    return stats;
+  }
+
+
+  void CRTTimestampCorrector::reset() {
+    fFEBs.fill(FEBState_t{});
+  }
+
+
+  std::pair<bool, bool> CRTTimestampCorrector::correctTime(uint64_t& time, TimeState_t& state,
+    bool overflow, bool reference, uint64_t counterPeriod, uint64_t referencePeriod)
+  {
+    bool rolledOver = false, aligned = false;
+
+    uint64_t measured = time;
+    if (overflow && (counterPeriod > 0) && state.started && (measured < state.last - state.offset)) {
+      // number of periods to bring the measurement after the previous one
+      uint64_t const behind = state.last - state.offset - measured;
+      measured += ((behind + counterPeriod - 1) / counterPeriod) * counterPeriod;
+      rolledOver = true;
+    }
+
+    if (reference && (referencePeriod > 0)) {
+      uint64_t const pulse = ((measured + referencePeriod / 2) / referencePeriod) * referencePeriod;
+      state.offset = static_cast<int64_t>(pulse - measured);
+      aligned = true;
+    }
+
+    time = measured + state.offset;
+    state.last = time;
+    state.started = true;
+    return { rolledOver, aligned };
+  }
+
+} // namespace icarus::crt
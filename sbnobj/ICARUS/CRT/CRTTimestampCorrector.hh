@@ -0,0 +1,101 @@
+#ifndef ICCRTTimestampCorrector_hh_
+#define ICCRTTimestampCorrector_hh_
+
+#include "sbnobj/ICARUS/CRT/CRTData.hh"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace icarus::crt {
+
+  /**
+   * @brief Corrects the timestamps of CRT data, one FEB at a time
+   *
+   * The hits of each FEB (`CRTData::fMac5`) are processed in order of
+   * `CRTData::fEntry`, keeping a small fixed state per FEB. For each of the
+   * two timestamps (`fTs0` and `fTs1`) independently:
+   *
+   *  1. a hit flagged as overflow (`IsOverflow_TS0()`, `IsOverflow_TS1()`)
+   *     has a counter which was not restarted and rolled over: the counter
+   *     period (`ts0CounterPeriod`, `ts1CounterPeriod`) is added to its
+   *     timestamp until it is not earlier than the previous timestamp of the
+   *     same FEB;
+   *  2. a hit flagged as reference (`IsReference_TS0()`, `IsReference_TS1()`)
+   *     is a reference pulse happening at a multiple of the reference period
+   *     (`ts0ReferencePeriod`, `ts1ReferencePeriod`): the difference between
+   *     that time and the measured one is applied to this hit and to all the
+   *     following hits of the same FEB.
+   *
+   * A period set to `0` disables the corresponding correction.
+   *
+   * The corrector keeps its state between calls, so that data can be processed
+   * in sequential chunks (e.g. events); `reset()` clears it (e.g. at a new run).
+   * Since the FEBs are independent, a caller may also use a corrector per FEB.
+   */
+  class CRTTimestampCorrector {
+
+  public:
+
+    struct Config_t {
+      uint64_t ts0CounterPeriod   = 0; ///< Roll over period of the T0 counter [ns] (0: no correction).
+      uint64_t ts1CounterPeriod   = 0; ///< Roll over period of the T1 counter [ns] (0: no correction).
+      uint64_t ts0ReferencePeriod = 0; ///< Period of the T0 reference pulses [ns] (0: no alignment).
+      uint64_t ts1ReferencePeriod = 0; ///< Period of the T1 reference pulses [ns] (0: no alignment).
+    };
+
+    /// Number of corrections applied.
+    struct Stats_t {
+      std::size_t nHits = 0;
+      std::size_t nOverflowTS0 = 0;
+      std::size_t nOverflowTS1 = 0;
+      std::size_t nReferenceTS0 = 0;
+      std::size_t nReferenceTS1 = 0;
+
+      Stats_t& operator+=(Stats_t const& other);
+    };
+
+    CRTTimestampCorrector(): CRTTimestampCorrector(Config_t{}) {}
+    explicit CRTTimestampCorrector(Config_t const& config): fConfig(config) { reset(); }
+
+    /**
+     * @brief Corrects the timestamps of all the `data`.
+     *
+     * The hits are grouped by FEB and processed in `fEntry` order, without
+     * changing their order in `data`.
+     */
+    Stats_t correct(std::vector<CRTData>& data);
+
+    /// Corrects the timestamps of `hit`, which must follow the hits of its FEB already processed.
+    Stats_t correct(CRTData& hit);
+
+    /// Forgets the state of all the FEBs.
+    void reset();
+
+  private:
+
+    /// State of one timestamp of a FEB.
+    struct TimeState_t {
+      uint64_t last = 0; ///< Last corrected timestamp.
+      int64_t offset = 0; ///< Correction from the last reference pulse.
+      bool started = false; ///< Whether `last` is set.
+    };
+
+    struct FEBState_t { TimeState_t ts0, ts1; };
+
+    Config_t fConfig;
+
+    std::array<FEBState_t, 256> fFEBs; ///< State of each FEB, by address.
+
+    /// Corrects the timestamp `time`; returns which corrections were applied.
+    static std::pair<bool, bool> correctTime(uint64_t& time, TimeState_t& state,
+      bool overflow, bool reference, uint64_t counterPeriod, uint64_t referencePeriod);
+
+  };
+
+} // namespace icarus::crt
+
+
+#endif
@@ -0,0 +1,109 @@
+#include "sbnobj/ICARUS/CRT/CompactCRTDataCollection.hh"
+
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+  static_assert(sizeof(icarus::crt::CRTData::fAdc) / sizeof(icarus::crt::CRTData::fAdc[0]) == 64,
+    "The channel mask of CompactCRTDataCollection supports exactly 64 channels.");
+
+  int64_t delta(uint64_t time, uint64_t reference)
+    { return static_cast<int64_t>(time - reference); }
+
+  uint64_t undelta(int64_t delta, uint64_t reference)
+    { return reference + static_cast<uint64_t>(delta); }
+
+} // local namespace
+
+
+namespace icarus::crt {
+
+  CompactCRTDataCollection CompactCRTDataCollection::compress
+    (std::vector<CRTData> const& data, uint16_t threshold /* = 0 */)
+  {
+    std::size_t const n = data.size();
+
+    CompactCRTDataCollection compact;
+    compact.fThreshold = threshold;
+    compact.fMac5.reserve(n);
+    compact.fEntry.reserve(n);
+    compact.fTs0.reserve(n);
+    compact.fTs1.reserve(n);
+    compact.fFlags.reserve(n);
+    compact.fThisPollStartDelta.reserve(n);
+    compact.fLastPollStartDelta.reserve(n);
+    compact.fHitsInPoll.reserve(n);
+    compact.fCoinc.reserve(n);
+    compact.fLastAcceptedTimestampDelta.reserve(n);
+    compact.fLostHits.reserve(n);
+    compact.fADCMask.reserve(n);
+
+    for (CRTData const& hit: data) {
+      compact.fMac5.push_back(hit.fMac5);
+      compact.fEntry.push_back(hit.fEntry);
+      compact.fTs0.push_back(hit.fTs0);
+      compact.fTs1.push_back(hit.fTs1);
+      compact.fFlags.push_back(hit.fFlags);
+      compact.fThisPollStartDelta.push_back(delta(hit.fThisPollStart, hit.fTs0));
+      compact.fLastPollStartDelta.push_back(delta(hit.fLastPollStart, hit.fTs0));
+      compact.fHitsInPoll.push_back(hit.fHitsInPoll);
+      compact.fCoinc.push_back(hit.fCoinc);
+      compact.fLastAcceptedTimestampDelta.push_back(delta(hit.fLastAcceptedTimestamp, hit.fTs0));
+      compact.fLostHits.push_back(hit.fLostHits);
+
+      uint64_t mask = 0;
+      for (std::size_t c = 0; c < 64; ++c) {
+        if (hit.fAdc[c] <= threshold) continue;
+        mask |= uint64_t{ 1 } << c;
+        compact.fADC.push_back(hit.fAdc[c]);
+      }
+      compact.fADCMask.push_back(mask);
+    }
+    return compact;
+  }
+
+
+  std::vector<CRTData> CompactCRTDataCollection::expand() const {
+    std::size_t const n = size();
+    if ((fEntry.size() != n) || (fTs0.size() != n) || (fTs1.size() != n) || (fFlags.size() != n)
+      || (fThisPollStartDelta.size() != n) || (fLastPollStartDelta.size() != n)
+      || (fHitsInPoll.size() != n) || (fCoinc.size() != n)
+      || (fLastAcceptedTimestampDelta.size() != n) || (fLostHits.size() != n)
+      || (fADCMask.size() != n))
+    {
+      throw std::runtime_error("icarus::crt::CompactCRTDataCollection::expand(): "
+        "inconsistent content for " + std::to_string(n) + " hits");
+    }
+
+    std::vector<CRTData> data(n);
+    uint16_t const* adc = fADC.data();
+    uint16_t const* const adcEnd = adc + fADC.size();
+    for (std::size_t i = 0; i < n; ++i) {
+      CRTData& hit = data[i];
+      hit.fMac5 = fMac5[i];
+      hit.fEntry = fEntry[i];
+      hit.fTs0 = fTs0[i];
+      hit.fTs1 = fTs1[i];
+      hit.fFlags = fFlags[i];
+      hit.fThisPollStart = undelta(fThisPollStartDelta[i], hit.fTs0);
+      hit.fLastPollStart = undelta(fLastPollStartDelta[i], hit.fTs0);
+      hit.fHitsInPoll = fHitsInPoll[i];
+      hit.fCoinc = fCoinc[i];
+      hit.fLastAcceptedTimestamp = undelta(fLastAcceptedTimestampDelta[i], hit.fTs0);
+      hit.fLostHits = fLostHits[i];
+
+      uint64_t const mask = fADCMask[i];
+      for (std::size_t c = 0; c < 64; ++c) {
+        if (!((mask >> c) & 1)) continue;
+        if (adc == adcEnd) {
+          throw std::runtime_error("icarus::crt::CompactCRTDataCollection::expand(): "
+            "only " + std::to_string(fADC.size()) + " ADC values stored");
+        }
+        hit.fAdc[c] = *adc++;
+      }
+    }
+    return data;
+  }
+
+} // namespace icarus::crt
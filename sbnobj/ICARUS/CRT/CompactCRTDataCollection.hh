@@ -0,0 +1,76 @@
+#ifndef ICCompactCRTDataCollection_hh_
+#define ICCompactCRTDataCollection_hh_
+
+#include "sbnobj/ICARUS/CRT/CRTData.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace icarus::crt {
+
+  /**
+   * @brief Zero-suppressed storage of a collection of `CRTData`
+   *
+   * This data product stores a `std::vector<icarus::crt::CRTData>` in a more
+   * compact form, to be used instead of it in the output files:
+   *
+   *  * only the ADC above a threshold are stored, with a bit mask of the
+   *    channels they belong to; the ADC of the other channels are restored as
+   *    `0`, so that with the default threshold of `0` no information is lost;
+   *  * the poll bookkeeping timestamps are stored as difference from `fTs0`;
+   *  * each data member of `CRTData` is stored in its own array, which ROOT
+   *    compresses better than the interleaved members of the hits.
+   *
+   * The `CRTData` objects are restored all together by `expand()`:
+   *
+   *     auto const& compact = event.getProduct<icarus::crt::CompactCRTDataCollection>(tag);
+   *     std::vector<icarus::crt::CRTData> const data = compact.expand();
+   *
+   */
+  class CompactCRTDataCollection {
+
+  public:
+
+    CompactCRTDataCollection() = default;
+
+    /// Returns the compact form of `data`, keeping only ADC above `threshold`.
+    static CompactCRTDataCollection compress(std::vector<CRTData> const& data, uint16_t threshold = 0);
+
+    /// Returns the stored `CRTData` collection.
+    std::vector<CRTData> expand() const;
+
+    std::size_t size() const { return fMac5.size(); }
+    bool empty() const { return fMac5.empty(); }
+
+    /// Returns the number of ADC values stored.
+    std::size_t nStoredADC() const { return fADC.size(); }
+
+    /// Returns the threshold used in the zero suppression.
+    uint16_t threshold() const { return fThreshold; }
+
+  private:
+
+    uint16_t fThreshold { 0 }; ///< ADC at or below this value are not stored.
+
+    std::vector<uint8_t>  fMac5;
+    std::vector<uint32_t> fEntry;
+    std::vector<uint64_t> fTs0;
+    std::vector<uint64_t> fTs1;
+    std::vector<uint32_t> fFlags;
+    std::vector<int64_t>  fThisPollStartDelta;         ///< `fThisPollStart - fTs0`
+    std::vector<int64_t>  fLastPollStartDelta;         ///< `fLastPollStart - fTs0`
+    std::vector<uint32_t> fHitsInPoll;
+    std::vector<uint32_t> fCoinc;
+    std::vector<int64_t>  fLastAcceptedTimestampDelta; ///< `fLastAcceptedTimestamp - fTs0`
+    std::vector<uint16_t> fLostHits;
+
+    std::vector<uint64_t> fADCMask; ///< Channels with a stored ADC, per hit (bit `c` for channel `c`).
+    std::vector<uint16_t> fADC;     ///< Stored ADC, per hit and in channel order.
+
+  };
+
+} // namespace icarus::crt
+
+
+#endif
@@ -0,0 +1,109 @@
+/**
+ * @file   sbnobj/ICARUS/PMT/Data/CompactWaveformBaselines.cxx
+ * @brief  Compact storage of the baselines of a collection of waveforms.
+ * @see    sbnobj/ICARUS/PMT/Data/CompactWaveformBaselines.h
+ */
+
+// library header
+#include "sbnobj/ICARUS/PMT/Data/CompactWaveformBaselines.h"
+
+// C/C++ standard libraries
+#include <ostream>
+#include <algorithm> // std::min(), std::max()
+#include <stdexcept> // std::runtime_error
+#include <limits>
+#include <string>
+#include <cmath> // std::floor()
+
+
+//------------------------------------------------------------------------------
+auto icarus::CompactWaveformBaselines::toBaselines() const
+  -> std::vector<icarus::WaveformBaseline>
+{
+  std::vector<icarus::WaveformBaseline> baselines;
+  baselines.reserve(size());
+  for (Quantized_t const value: fValues)
+    baselines.emplace_back(fOffset + fResolution * value);
+  return baselines;
+} // icarus::CompactWaveformBaselines::toBaselines()
+
+
+//------------------------------------------------------------------------------
+void icarus::CompactWaveformBaselines::toValues(Baseline_t* values) const {
+  std::size_t const n = size();
+  Quantized_t const* const stored = fValues.data();
+  for (std::size_t i = 0U; i < n; ++i)
+    values[i] = fOffset + fResolution * stored[i];
+} // icarus::CompactWaveformBaselines::toValues()
+
+
+//------------------------------------------------------------------------------
+auto icarus::CompactWaveformBaselines::fromBaselines(
+  std::vector<icarus::WaveformBaseline> const& baselines,
+  Baseline_t resolution /* = DefaultResolution */
+) -> CompactWaveformBaselines {
+  
+  std::vector<Baseline_t> values;
+  values.reserve(baselines.size());
+  for (icarus::WaveformBaseline const& baseline: baselines)
+    values.push_back(baseline.baseline());
+  return fromValues(values.data(), values.size(), resolution);
+  
+} // icarus::CompactWaveformBaselines::fromBaselines()
+
+
+//------------------------------------------------------------------------------
+auto icarus::CompactWaveformBaselines::fromValues(
+  Baseline_t const* values, std::size_t n,
+  Baseline_t resolution /* = DefaultResolution */
+) -> CompactWaveformBaselines {
+  
+  if (!(resolution > 0.0f)) {
+    throw std::runtime_error("icarus::CompactWaveformBaselines: resolution ("
+      + std::to_string(resolution) + ") must be positive.");
+  }
+  
+  CompactWaveformBaselines compact;
+  compact.fResolution = resolution;
+  if (n == 0U) return compact;
+  
+  // the loops are kept free of branches, so that the compiler can vectorize
+  Baseline_t min = values[0], max = values[0];
+  for (std::size_t i = 1U; i < n; ++i) {
+    min = std::min(min, values[i]);
+    max = std::max(max, values[i]);
+  } // for
+  
+  // the range is centered on the offset; a little room is left for rounding
+  constexpr Baseline_t MaxQuantized
+    = std::numeric_limits<Quantized_t>::max() - 1;
+  double const halfRange = (static_cast<double>(max) - min) / 2.0;
+  compact.fOffset = static_cast<Baseline_t>(min + halfRange);
+  compact.fResolution = std::max
+    (resolution, static_cast<Baseline_t>(halfRange / MaxQuantized) * 1.0001f);
+  
+  Baseline_t const offset = compact.fOffset;
+  Baseline_t const scale = 1.0f / compact.fResolution;
+  compact.fValues.resize(n);
+  Quantized_t* const stored = compact.fValues.data();
+  for (std::size_t i = 0U; i < n; ++i) {
+    Baseline_t const q = std::floor((values[i] - offset) * scale + 0.5f);
+    stored[i] = static_cast<Quantized_t>
+      (std::min(std::max(q, -MaxQuantized), MaxQuantized));
+  } // for
+  
+  return compact;
+} // icarus::CompactWaveformBaselines::fromValues()
+
+
+//------------------------------------------------------------------------------
+std::ostream& icarus::operator<<
+  (std::ostream& out, icarus::CompactWaveformBaselines const& baselines)
+{
+  out << baselines.size() << " baselines at " << baselines.offset()
+    << " + " << baselines.resolution() << " x n";
+  return out;
+} // icarus::operator<< (CompactWaveformBaselines)
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,150 @@
+/**
+ * @file   sbnobj/ICARUS/PMT/Data/CompactWaveformBaselines.h
+ * @brief  Compact storage of the baselines of a collection of waveforms.
+ * @see    sbnobj/ICARUS/PMT/Data/CompactWaveformBaselines.cxx
+ */
+ 
+#ifndef SBNOBJ_ICARUS_PMT_DATA_COMPACTWAVEFORMBASELINES_H
+#define SBNOBJ_ICARUS_PMT_DATA_COMPACTWAVEFORMBASELINES_H
+
+// ICARUS libraries
+#include "sbnobj/ICARUS/PMT/Data/WaveformBaseline.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <iosfwd> // std::ostream
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int16_t
+
+
+//------------------------------------------------------------------------------
+namespace icarus {
+  
+  class CompactWaveformBaselines;
+  
+  /// Prints a summary of the baseline collection into a stream.
+  std::ostream& operator<<
+    (std::ostream& out, icarus::CompactWaveformBaselines const& baselines);
+  
+} // namespace icarus
+
+/**
+ * @brief Baselines of a collection of waveforms, in fixed point format.
+ * 
+ * This object holds the baselines of all the waveforms of a collection,
+ * in the same order as the waveforms (the baseline of the waveform at index
+ * `i` of the collection is `baseline(i)`), so that no association is needed.
+ * 
+ * Each baseline is stored as a 16-bit integer `q` representing the value
+ * `offset() + resolution() * q`, with offset and resolution shared by all the
+ * baselines of the collection. The precision of the stored values is then
+ * half the resolution.
+ * 
+ * The conversion from and to `icarus::WaveformBaseline` is performed for the
+ * whole collection at once:
+ * ~~~~{.cpp}
+ * std::vector<icarus::WaveformBaseline> const& baselines = ...;
+ * 
+ * icarus::CompactWaveformBaselines const compact
+ *   = icarus::CompactWaveformBaselines::fromBaselines(baselines);
+ * 
+ * std::vector<icarus::WaveformBaseline> const restored = compact.toBaselines();
+ * ~~~~
+ */
+class icarus::CompactWaveformBaselines {
+  
+    public:
+  
+  using Baseline_t = icarus::WaveformBaseline::Baseline_t;
+  
+  using Quantized_t = std::int16_t; ///< Type of a stored baseline.
+  
+  /// Default resolution used by `fromBaselines()` [ADC counts].
+  static constexpr Baseline_t DefaultResolution = 1.0f / 64.0f;
+  
+  
+  /// Constructor: an empty collection.
+  CompactWaveformBaselines() = default;
+  
+  
+  // --- BEGIN -- Access -------------------------------------------------------
+  /// @name Access
+  /// @{
+  
+  /// Returns the number of baselines in the collection.
+  std::size_t size() const { return fValues.size(); }
+  
+  /// Returns whether the collection has no baseline.
+  bool empty() const { return fValues.empty(); }
+  
+  /// Returns the value of the baseline at position `i` of the collection.
+  Baseline_t baseline(std::size_t i) const
+    { return fOffset + fResolution * fValues[i]; }
+  
+  /// Returns the baseline at position `i` of the collection.
+  icarus::WaveformBaseline operator[] (std::size_t i) const
+    { return { baseline(i) }; }
+  
+  /// Returns the resolution of the stored values.
+  Baseline_t resolution() const { return fResolution; }
+  
+  /// Returns the value corresponding to a stored `0`.
+  Baseline_t offset() const { return fOffset; }
+  
+  /// Returns the stored values.
+  std::vector<Quantized_t> const& values() const { return fValues; }
+  
+  /// @}
+  // --- END ---- Access -------------------------------------------------------
+  
+  
+  // --- BEGIN -- Conversions --------------------------------------------------
+  /// @name Conversions
+  /// @{
+  
+  /// Returns all the baselines, in the same order as in the collection.
+  std::vector<icarus::WaveformBaseline> toBaselines() const;
+  
+  /// Writes all the baseline values into `values` (of `size()` elements).
+  void toValues(Baseline_t* values) const;
+  
+  /**
+   * @brief Creates a compact collection from `baselines`.
+   * @param baselines the baselines to be stored
+   * @param resolution (default: `DefaultResolution`) finest resolution to use
+   * @return the compact collection
+   * 
+   * The baselines are stored with the specified resolution, or with the
+   * finest resolution that fits the range of their values in 16 bits if that
+   * is coarser.
+   */
+  static CompactWaveformBaselines fromBaselines(
+    std::vector<icarus::WaveformBaseline> const& baselines,
+    Baseline_t resolution = DefaultResolution
+    );
+  
+  /// Creates a compact collection from `n` baseline `values`
+  /// (see `fromBaselines()`).
+  static CompactWaveformBaselines fromValues(
+    Baseline_t const* values, std::size_t n,
+    Baseline_t resolution = DefaultResolution
+    );
+  
+  /// @}
+  // --- END ---- Conversions --------------------------------------------------
+  
+  
+    private:
+  
+  Baseline_t fOffset = 0.0f; ///< Value of a stored `0`.
+  
+  Baseline_t fResolution = DefaultResolution; ///< Value of one stored unit.
+  
+  std::vector<Quantized_t> fValues; ///< Stored baselines.
+  
+}; // icarus::CompactWaveformBaselines
+
+
+//------------------------------------------------------------------------------
+
+#endif // SBNOBJ_ICARUS_PMT_DATA_COMPACTWAVEFORMBASELINES_H
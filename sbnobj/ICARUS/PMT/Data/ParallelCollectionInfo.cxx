@@ -0,0 +1,80 @@
+/**
+ * @file   sbnobj/ICARUS/PMT/Data/ParallelCollectionInfo.cxx
+ * @brief  Information on a collection aligned element by element to another.
+ * @see    sbnobj/ICARUS/PMT/Data/ParallelCollectionInfo.h
+ */
+
+// library header
+#include "sbnobj/ICARUS/PMT/Data/ParallelCollectionInfo.h"
+
+// SBN libraries
+#include "sbnobj/Common/Utilities/HashMixing.h" // sbn::details::mixHash()
+
+// C/C++ standard libraries
+#include <ostream>
+#include <iomanip> // std::hex, std::dec
+#include <utility> // std::move()
+#include <cstring> // std::memcpy()
+
+
+//------------------------------------------------------------------------------
+bool icarus::ParallelCollectionInfo::matches
+  (std::vector<raw::OpDetWaveform> const& waveforms) const
+{
+  if (waveforms.size() != referenceSize) return false;
+  return !hasFingerprint()
+    || (waveformCollectionFingerprint(waveforms) == referenceFingerprint);
+} // icarus::ParallelCollectionInfo::matches()
+
+
+//------------------------------------------------------------------------------
+auto icarus::ParallelCollectionInfo::makeFor
+  (std::vector<raw::OpDetWaveform> const& waveforms, std::string tag /* = "" */)
+  -> ParallelCollectionInfo
+{
+  return { std::move(tag), waveforms.size(),
+    waveformCollectionFingerprint(waveforms) };
+} // icarus::ParallelCollectionInfo::makeFor()
+
+
+//------------------------------------------------------------------------------
+std::uint64_t icarus::waveformCollectionFingerprint
+  (std::vector<raw::OpDetWaveform> const& waveforms)
+{
+  /*
+   * Each value is folded in the hash with `sbn::details::mixHash()`;
+   * the hash value reserved to mark the absence of a fingerprint is remapped.
+   */
+  using sbn::details::mixHash;
+  
+  std::uint64_t hash = mixHash(0U, waveforms.size());
+  for (raw::OpDetWaveform const& waveform: waveforms) {
+    raw::TimeStamp_t const timeStamp = waveform.TimeStamp();
+    std::uint64_t timeBits;
+    static_assert(sizeof(timeBits) == sizeof(timeStamp));
+    std::memcpy(&timeBits, &timeStamp, sizeof(timeBits));
+    
+    hash = mixHash(hash, waveform.ChannelNumber());
+    hash = mixHash(hash, timeBits);
+    hash = mixHash(hash, waveform.size());
+  } // for
+  
+  return (hash == ParallelCollectionInfo::NoFingerprint)? ~hash: hash;
+} // icarus::waveformCollectionFingerprint()
+
+
+//------------------------------------------------------------------------------
+std::ostream& icarus::operator<<
+  (std::ostream& out, icarus::ParallelCollectionInfo const& info)
+{
+  out << "parallel to " << info.referenceSize << " elements of '"
+    << info.referenceTag << "'";
+  if (info.hasFingerprint()) {
+    out << " (fingerprint: 0x" << std::hex << info.referenceFingerprint
+      << std::dec << ")";
+  }
+  return out;
+} // icarus::operator<< (ParallelCollectionInfo)
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,110 @@
+/**
+ * @file   sbnobj/ICARUS/PMT/Data/ParallelCollectionInfo.h
+ * @brief  Information on a collection aligned element by element to another.
+ * @see    sbnobj/ICARUS/PMT/Data/ParallelCollectionInfo.cxx
+ */
+ 
+#ifndef SBNOBJ_ICARUS_PMT_DATA_PARALLELCOLLECTIONINFO_H
+#define SBNOBJ_ICARUS_PMT_DATA_PARALLELCOLLECTIONINFO_H
+
+// LArSoft libraries
+#include "lardataobj/RawData/OpDetWaveform.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <string>
+#include <iosfwd> // std::ostream
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+
+
+//------------------------------------------------------------------------------
+namespace icarus {
+  
+  struct ParallelCollectionInfo;
+  
+  /// Prints the information into a stream.
+  std::ostream& operator<<
+    (std::ostream& out, icarus::ParallelCollectionInfo const& info);
+  
+  /**
+   * @brief Returns a fingerprint of the content of a waveform collection.
+   * 
+   * The fingerprint depends on the channel, time stamp and number of samples
+   * of each of the `waveforms`, and on their order, but not on the sample
+   * values. It is used to verify that a collection is the one a parallel
+   * collection was aligned to (`icarus::ParallelCollectionInfo`).
+   */
+  std::uint64_t waveformCollectionFingerprint
+    (std::vector<raw::OpDetWaveform> const& waveforms);
+  
+} // namespace icarus
+
+
+/**
+ * @brief Describes the collection a parallel collection is aligned to.
+ * 
+ * A _parallel collection_ has one element for each element of another
+ * collection (the _reference_ collection), in the same order: the element at
+ * index `i` of the parallel collection refers to the element at index `i` of
+ * the reference. For example, a `std::vector<icarus::WaveformBaseline>`
+ * parallel to a `std::vector<raw::OpDetWaveform>` holds the baseline of each
+ * waveform in the same position as the waveform. This replaces a one-to-one
+ * association: finding the baseline of a waveform is direct indexing.
+ * 
+ * This object is stored together with the parallel collection (usually with
+ * the same producer and instance name), and describes the reference
+ * collection, so that the alignment can be verified when reading:
+ * its input tag (for information only), its size and its content fingerprint
+ * (e.g. `icarus::waveformCollectionFingerprint()`).
+ * 
+ * The utility `icarus::ParallelCollectionView` reads the parallel and the
+ * reference collections together, checking their alignment.
+ * 
+ * Example of writing (in a producer):
+ * ~~~~{.cpp}
+ * auto const& waveforms = event.getProduct<std::vector<raw::OpDetWaveform>>
+ *   (fWaveformTag);
+ * std::vector<icarus::WaveformBaseline> baselines;
+ * for (raw::OpDetWaveform const& waveform: waveforms)
+ *   baselines.push_back(computeBaseline(waveform));
+ * 
+ * event.put(std::make_unique<std::vector<icarus::WaveformBaseline>>
+ *   (std::move(baselines)));
+ * event.put(std::make_unique<icarus::ParallelCollectionInfo>
+ *   (icarus::ParallelCollectionInfo::makeFor(waveforms, fWaveformTag.encode()))
+ *   );
+ * ~~~~
+ */
+struct icarus::ParallelCollectionInfo {
+  
+  /// Value of fingerprint standing for "not available".
+  static constexpr std::uint64_t NoFingerprint = 0U;
+  
+  /// Input tag of the reference collection (informative only).
+  std::string referenceTag;
+  
+  /// Number of elements of the reference collection.
+  std::uint64_t referenceSize = 0U;
+  
+  /// Fingerprint of the reference collection (or `NoFingerprint`).
+  std::uint64_t referenceFingerprint = NoFingerprint;
+  
+  
+  /// Returns whether the fingerprint is available.
+  bool hasFingerprint() const
+    { return referenceFingerprint != NoFingerprint; }
+  
+  /// Returns whether `waveforms` match the description of the reference.
+  bool matches(std::vector<raw::OpDetWaveform> const& waveforms) const;
+  
+  /// Returns the information for a collection parallel to `waveforms`.
+  static ParallelCollectionInfo makeFor
+    (std::vector<raw::OpDetWaveform> const& waveforms, std::string tag = "");
+  
+}; // icarus::ParallelCollectionInfo
+
+
+//------------------------------------------------------------------------------
+
+#endif // SBNOBJ_ICARUS_PMT_DATA_PARALLELCOLLECTIONINFO_H
@@ -0,0 +1,194 @@
+/**
+ * @file   sbnobj/ICARUS/PMT/Data/ParallelCollectionView.h
+ * @brief  Joint access to two collections aligned element by element.
+ * @see    sbnobj/ICARUS/PMT/Data/ParallelCollectionInfo.h
+ * 
+ * This is a header-only library.
+ */
+ 
+#ifndef SBNOBJ_ICARUS_PMT_DATA_PARALLELCOLLECTIONVIEW_H
+#define SBNOBJ_ICARUS_PMT_DATA_PARALLELCOLLECTIONVIEW_H
+
+// ICARUS libraries
+#include "sbnobj/ICARUS/PMT/Data/ParallelCollectionInfo.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <utility> // std::pair
+#include <functional> // std::less<>
+#include <stdexcept> // std::runtime_error, std::out_of_range
+#include <string>
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+namespace icarus {
+  
+  template <typename Data, typename Ref>
+  class ParallelCollectionView;
+  
+  /**
+   * @brief Returns a view of `data` parallel to the `waveforms`.
+   * @param data the parallel collection
+   * @param waveforms the reference waveform collection
+   * @param info the information stored with the parallel collection
+   * @return a view of `data` and `waveforms`
+   * @throw std::runtime_error if `waveforms` do not match `info`, or `data`
+   *        does not have the same size as `waveforms`
+   */
+  template <typename Data>
+  ParallelCollectionView<Data, raw::OpDetWaveform> makeParallelWaveformView(
+    std::vector<Data> const& data,
+    std::vector<raw::OpDetWaveform> const& waveforms,
+    icarus::ParallelCollectionInfo const& info
+    );
+  
+} // namespace icarus
+
+
+/**
+ * @brief Accesses a collection and the reference collection it is aligned to.
+ * @tparam Data type of the elements of the parallel collection
+ * @tparam Ref type of the elements of the reference collection
+ * @see `icarus::ParallelCollectionInfo`
+ * 
+ * The element `i` of the parallel collection (`data(i)`) is associated with
+ * the element `i` of the reference collection (`reference(i)`).
+ * Given a reference element (e.g. a waveform from the reference collection),
+ * its associated data (e.g. its baseline) is returned by `dataFor()` in
+ * constant time.
+ * 
+ * The view does not own the collections, which must stay valid for as long as
+ * the view is used.
+ * 
+ * Example:
+ * ~~~~{.cpp}
+ * auto const& baselines
+ *   = event.getProduct<std::vector<icarus::WaveformBaseline>>(fBaselineTag);
+ * auto const& info
+ *   = event.getProduct<icarus::ParallelCollectionInfo>(fBaselineTag);
+ * auto const& waveforms
+ *   = event.getProduct<std::vector<raw::OpDetWaveform>>(fWaveformTag);
+ * 
+ * auto const waveformBaselines
+ *   = icarus::makeParallelWaveformView(baselines, waveforms, info);
+ * 
+ * for (raw::OpDetWaveform const& waveform: waveforms) {
+ *   icarus::WaveformBaseline const& baseline
+ *     = waveformBaselines.dataFor(waveform);
+ *   // ...
+ * }
+ * ~~~~
+ */
+template <typename Data, typename Ref>
+class icarus::ParallelCollectionView {
+  
+    public:
+  
+  using Data_t = Data; ///< Type of the elements of the parallel collection.
+  using Ref_t = Ref; ///< Type of the elements of the reference collection.
+  
+  /**
+   * @brief Constructor: views `data` as parallel to `reference`.
+   * @throw std::runtime_error if the two collections have different size
+   */
+  ParallelCollectionView
+    (std::vector<Data> const& data, std::vector<Ref> const& reference);
+  
+  /// Returns the number of elements in each of the collections.
+  std::size_t size() const { return fData->size(); }
+  
+  /// Returns whether the collections are empty.
+  bool empty() const { return fData->empty(); }
+  
+  /// Returns the element `i` of the parallel collection.
+  Data const& data(std::size_t i) const { return (*fData)[i]; }
+  
+  /// Returns the element `i` of the reference collection.
+  Ref const& reference(std::size_t i) const { return (*fReference)[i]; }
+  
+  /// Returns the element `i` of both the collections.
+  std::pair<Data const&, Ref const&> operator[] (std::size_t i) const
+    { return { data(i), reference(i) }; }
+  
+  /**
+   * @brief Returns the data associated with an element of the reference.
+   * @param ref an element of the reference collection (not a copy of it)
+   * @return the element of the parallel collection associated with `ref`
+   * @throw std::out_of_range if `ref` is not in the reference collection
+   */
+  Data const& dataFor(Ref const& ref) const { return data(indexOf(ref)); }
+  
+  /// Returns the index in the reference collection of `ref` (see `dataFor()`).
+  std::size_t indexOf(Ref const& ref) const;
+  
+  /// Returns the parallel collection.
+  std::vector<Data> const& dataCollection() const { return *fData; }
+  
+  /// Returns the reference collection.
+  std::vector<Ref> const& referenceCollection() const { return *fReference; }
+  
+  
+    private:
+  
+  std::vector<Data> const* fData; ///< The parallel collection.
+  std::vector<Ref> const* fReference; ///< The reference collection.
+  
+}; // icarus::ParallelCollectionView
+
+
+//------------------------------------------------------------------------------
+//--- template implementation
+//------------------------------------------------------------------------------
+template <typename Data, typename Ref>
+icarus::ParallelCollectionView<Data, Ref>::ParallelCollectionView
+  (std::vector<Data> const& data, std::vector<Ref> const& reference)
+  : fData{ &data }, fReference{ &reference }
+{
+  if (data.size() != reference.size()) {
+    throw std::runtime_error("icarus::ParallelCollectionView: "
+      + std::to_string(data.size()) + " elements parallel to "
+      + std::to_string(reference.size()) + " reference elements.");
+  }
+} // icarus::ParallelCollectionView<>::ParallelCollectionView()
+
+
+//------------------------------------------------------------------------------
+template <typename Data, typename Ref>
+std::size_t icarus::ParallelCollectionView<Data, Ref>::indexOf
+  (Ref const& ref) const
+{
+  // pointer comparison within the collection: this is why copies won't work
+  std::less<Ref const*> const before;
+  Ref const* const begin = fReference->data();
+  if (before(&ref, begin) || !before(&ref, begin + fReference->size())) {
+    throw std::out_of_range("icarus::ParallelCollectionView::indexOf():"
+      " element is not part of the reference collection.");
+  }
+  return static_cast<std::size_t>(&ref - begin);
+} // icarus::ParallelCollectionView<>::indexOf()
+
+
+//------------------------------------------------------------------------------
+template <typename Data>
+auto icarus::makeParallelWaveformView(
+  std::vector<Data> const& data,
+  std::vector<raw::OpDetWaveform> const& waveforms,
+  icarus::ParallelCollectionInfo const& info
+) -> ParallelCollectionView<Data, raw::OpDetWaveform> {
+  
+  if (!info.matches(waveforms)) {
+    throw std::runtime_error("icarus::makeParallelWaveformView(): the "
+      + std::to_string(waveforms.size())
+      + " waveforms are not the ones the data is parallel to ("
+      + std::to_string(info.referenceSize) + " from '" + info.referenceTag
+      + "').");
+  }
+  return { data, waveforms };
+  
+} // icarus::makeParallelWaveformView()
+
+
+//------------------------------------------------------------------------------
+
+#endif // SBNOBJ_ICARUS_PMT_DATA_PARALLELCOLLECTIONVIEW_H
@@ -0,0 +1,148 @@
+/**
+ * @file   sbnobj/ICARUS/PMT/Data/WaveformBaselineEstimator.cxx
+ * @brief  Estimation of the baseline of PMT waveforms.
+ * @see    sbnobj/ICARUS/PMT/Data/WaveformBaselineEstimator.h
+ */
+
+// library header
+#include "sbnobj/ICARUS/PMT/Data/WaveformBaselineEstimator.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::min(), std::max(), std::fill()
+#include <iterator> // std::back_inserter()
+#include <cassert>
+
+
+//------------------------------------------------------------------------------
+icarus::WaveformBaselineEstimator::WaveformBaselineEstimator()
+  : WaveformBaselineEstimator(Config_t{})
+{}
+
+
+//------------------------------------------------------------------------------
+icarus::WaveformBaselineEstimator::WaveformBaselineEstimator(Config_t config)
+  : fConfig{ config }
+  , fCounts(NADCvalues, 0U)
+{}
+
+
+//------------------------------------------------------------------------------
+icarus::WaveformBaseline icarus::WaveformBaselineEstimator::operator()
+  (std::vector<raw::ADC_Count_t> const& samples)
+{
+  std::size_t const first = std::min(fConfig.firstSample, samples.size());
+  std::size_t const n = (fConfig.nSamples == 0U)
+    ? samples.size() - first
+    : std::min(fConfig.nSamples, samples.size() - first);
+  if (n == 0U) return {};
+  
+  raw::ADC_Count_t const* const begin = samples.data() + first;
+  raw::ADC_Count_t const* const end = begin + n;
+  
+  constexpr int MaxADC = static_cast<int>(NADCvalues - 1U);
+  
+  // the range is found in its own loop, which the compiler can vectorize
+  int min = MaxADC, max = 0;
+  for (auto it = begin; it != end; ++it) {
+    int const value = std::clamp<int>(*it, 0, MaxADC);
+    min = std::min(min, value);
+    max = std::max(max, value);
+  } // for
+  
+  for (auto it = begin; it != end; ++it)
+    ++fCounts[std::clamp<int>(*it, 0, MaxADC)];
+  
+  float const baseline = extractBaseline(n, min, max);
+  
+  // all the entries are in [ min, max ]: clearing them is enough
+  std::fill(fCounts.begin() + min, fCounts.begin() + max + 1, 0U);
+  
+  return { baseline };
+} // icarus::WaveformBaselineEstimator::operator()
+
+
+//------------------------------------------------------------------------------
+auto icarus::WaveformBaselineEstimator::estimate
+  (std::vector<raw::OpDetWaveform> const& waveforms)
+  -> std::vector<icarus::WaveformBaseline>
+{
+  std::vector<icarus::WaveformBaseline> baselines;
+  baselines.reserve(waveforms.size());
+  estimate(waveforms.begin(), waveforms.end(), std::back_inserter(baselines));
+  return baselines;
+} // icarus::WaveformBaselineEstimator::estimate()
+
+
+//------------------------------------------------------------------------------
+std::string icarus::WaveformBaselineEstimator::methodName(Method_t method) {
+  switch (method) {
+    case Method_t::Mode:          return "mode";
+    case Method_t::Median:        return "median";
+    case Method_t::TruncatedMean: return "truncated mean";
+  } // switch
+  return "<unknown>";
+} // icarus::WaveformBaselineEstimator::methodName()
+
+
+//------------------------------------------------------------------------------
+float icarus::WaveformBaselineEstimator::extractBaseline
+  (std::size_t n, std::size_t min, std::size_t max) const
+{
+  switch (fConfig.method) {
+    case Method_t::Mode:          return mode(min, max);
+    case Method_t::Median:        return median(n, min, max);
+    case Method_t::TruncatedMean: return truncatedMean(n, min, max);
+  } // switch
+  assert(false);
+  return 0.0f;
+} // icarus::WaveformBaselineEstimator::extractBaseline()
+
+
+//------------------------------------------------------------------------------
+std::size_t icarus::WaveformBaselineEstimator::median
+  (std::size_t n, std::size_t min, std::size_t max) const
+{
+  std::size_t const half = (n + 1U) / 2U;
+  std::size_t cumulative = 0U;
+  for (std::size_t value = min; value < max; ++value) {
+    cumulative += fCounts[value];
+    if (cumulative >= half) return value;
+  } // for
+  return max;
+} // icarus::WaveformBaselineEstimator::median()
+
+
+//------------------------------------------------------------------------------
+std::size_t icarus::WaveformBaselineEstimator::mode
+  (std::size_t min, std::size_t max) const
+{
+  std::size_t mode = min;
+  for (std::size_t value = min + 1U; value <= max; ++value)
+    if (fCounts[value] > fCounts[mode]) mode = value;
+  return mode;
+} // icarus::WaveformBaselineEstimator::mode()
+
+
+//------------------------------------------------------------------------------
+float icarus::WaveformBaselineEstimator::truncatedMean
+  (std::size_t n, std::size_t min, std::size_t max) const
+{
+  std::size_t const center = median(n, min, max);
+  std::size_t const low
+    = (center >= min + fConfig.truncationWidth)
+    ? center - fConfig.truncationWidth: min;
+  std::size_t const high = std::min<std::size_t>
+    (center + fConfig.truncationWidth, max);
+  
+  // the median itself is always included, so there is at least one entry
+  std::size_t sum = 0U, count = 0U;
+  for (std::size_t value = low; value <= high; ++value) {
+    sum += value * fCounts[value];
+    count += fCounts[value];
+  } // for
+  assert(count > 0U);
+  return static_cast<float>(static_cast<double>(sum) / count);
+} // icarus::WaveformBaselineEstimator::truncatedMean()
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,160 @@
+/**
+ * @file   sbnobj/ICARUS/PMT/Data/WaveformBaselineEstimator.h
+ * @brief  Estimation of the baseline of PMT waveforms.
+ * @see    sbnobj/ICARUS/PMT/Data/WaveformBaselineEstimator.cxx
+ */
+ 
+#ifndef SBNOBJ_ICARUS_PMT_DATA_WAVEFORMBASELINEESTIMATOR_H
+#define SBNOBJ_ICARUS_PMT_DATA_WAVEFORMBASELINEESTIMATOR_H
+
+// ICARUS libraries
+#include "sbnobj/ICARUS/PMT/Data/WaveformBaseline.h"
+
+// LArSoft libraries
+#include "lardataobj/RawData/OpDetWaveform.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <string>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+
+
+//------------------------------------------------------------------------------
+namespace icarus { class WaveformBaselineEstimator; }
+
+/**
+ * @brief Estimates the baseline of PMT waveforms from their ADC histogram.
+ * 
+ * The estimation is based on the histogram of the ADC values of the samples
+ * in the waveform, which are assumed to be 14-bit values (values outside
+ * that range are clamped into it).
+ * The supported estimators (`Method_t`) are:
+ * 
+ * * `Method_t::Mode`: the most frequent ADC value (the lowest one if there are
+ *   ties);
+ * * `Method_t::Median`: the median ADC value (the lower one if the number of
+ *   samples is even);
+ * * `Method_t::TruncatedMean`: the average of the samples within
+ *   `Config_t::truncationWidth` ADC counts from the median.
+ * 
+ * Only the samples in the range configured by `Config_t::firstSample` and
+ * `Config_t::nSamples` are used (all of them by default).
+ * The baseline of a waveform with no samples in the range is `0`.
+ * 
+ * The estimator keeps a histogram buffer which is reused for all the
+ * waveforms, so that the cost of the estimation of a waveform is proportional
+ * to its length and to the spread of its ADC values rather than to the size of
+ * the histogram. For the same reason, an estimator object must not be used
+ * concurrently: to process waveforms in parallel, use one estimator per thread
+ * (e.g. each on a different range of waveforms via `estimate(Iter, Iter)`).
+ * 
+ * Example:
+ * ~~~~{.cpp}
+ * icarus::WaveformBaselineEstimator estimateBaseline
+ *   { { icarus::WaveformBaselineEstimator::Method_t::Median } };
+ * 
+ * std::vector<icarus::WaveformBaseline> baselines
+ *   = estimateBaseline.estimate(waveforms);
+ * ~~~~
+ * will fill `baselines` with the baseline of each of the `waveforms`, in the
+ * same order.
+ */
+class icarus::WaveformBaselineEstimator {
+  
+    public:
+  
+  /// Number of bits of the ADC values.
+  static constexpr unsigned int ADCbits = 14U;
+  
+  /// Number of distinct ADC values.
+  static constexpr std::size_t NADCvalues = std::size_t{ 1 } << ADCbits;
+  
+  /// Available estimators.
+  enum class Method_t {
+    Mode,         ///< Most frequent value.
+    Median,       ///< Median value.
+    TruncatedMean ///< Average of the values close to the median.
+  }; // Method_t
+  
+  /// Configuration of the estimator.
+  struct Config_t {
+  
+    Method_t method = Method_t::Median; ///< Estimator of the baseline.
+    
+    std::size_t firstSample = 0U; ///< First sample to be used.
+    
+    /// Number of samples to be used (`0` for all the remaining ones).
+    std::size_t nSamples = 0U;
+    
+    /// Largest distance from the median of the samples used in the truncated
+    /// mean [ADC counts].
+    unsigned int truncationWidth = 10U;
+  
+  }; // Config_t
+  
+  
+  /// Constructor: uses the default configuration.
+  WaveformBaselineEstimator();
+  
+  /// Constructor: uses the specified configuration.
+  WaveformBaselineEstimator(Config_t config);
+  
+  /// Returns the configuration of this estimator.
+  Config_t const& config() const { return fConfig; }
+  
+  /// Returns the baseline of the specified waveform samples.
+  icarus::WaveformBaseline operator()
+    (std::vector<raw::ADC_Count_t> const& samples);
+  
+  /// Returns the baseline of all the `waveforms`, in the same order.
+  std::vector<icarus::WaveformBaseline> estimate
+    (std::vector<raw::OpDetWaveform> const& waveforms);
+  
+  /// Writes into `out` the baseline of each waveform in `[begin, end[`.
+  template <typename Iter, typename OIter>
+  OIter estimate(Iter begin, Iter end, OIter out);
+  
+  /// Returns the name of the specified method.
+  static std::string methodName(Method_t method);
+  
+  
+    private:
+  
+  using Count_t = std::uint32_t; ///< Type of histogram counts.
+  
+  Config_t fConfig; ///< Configuration.
+  
+  std::vector<Count_t> fCounts; ///< Histogram buffer, kept empty between uses.
+  
+  /// Returns the baseline with the configured method from the histogram,
+  /// which has `n` entries between `min` and `max` (included).
+  float extractBaseline(std::size_t n, std::size_t min, std::size_t max) const;
+  
+  /// Returns the lower median from the histogram.
+  std::size_t median(std::size_t n, std::size_t min, std::size_t max) const;
+  
+  /// Returns the mode from the histogram.
+  std::size_t mode(std::size_t min, std::size_t max) const;
+  
+  /// Returns the truncated mean from the histogram.
+  float truncatedMean(std::size_t n, std::size_t min, std::size_t max) const;
+  
+}; // icarus::WaveformBaselineEstimator
+
+
+//------------------------------------------------------------------------------
+//--- template implementation
+//------------------------------------------------------------------------------
+template <typename Iter, typename OIter>
+OIter icarus::WaveformBaselineEstimator::estimate
+  (Iter begin, Iter end, OIter out)
+{
+  while (begin != end) *out++ = this->operator() (*begin++);
+  return out;
+} // icarus::WaveformBaselineEstimator::estimate()
+
+
+//------------------------------------------------------------------------------
+
+#endif // SBNOBJ_ICARUS_PMT_DATA_WAVEFORMBASELINEESTIMATOR_H
@@ -0,0 +1,58 @@
+/**
+ * @file   sbnobj/ICARUS/PMT/Data/WaveformBaselineProfile.cxx
+ * @brief  A baseline for a waveform, varying along the waveform.
+ * @see    sbnobj/ICARUS/PMT/Data/WaveformBaselineProfile.h
+ */
+
+// library header
+#include "sbnobj/ICARUS/PMT/Data/WaveformBaselineProfile.h"
+
+// C/C++ standard libraries
+#include <ostream>
+#include <stdexcept> // std::runtime_error
+#include <string>
+#include <utility> // std::move()
+
+
+//------------------------------------------------------------------------------
+icarus::WaveformBaselineProfile::WaveformBaselineProfile(
+  std::size_t blockSize,
+  std::vector<Baseline_t> baselines, std::vector<Baseline_t> RMS
+)
+  : fBlockSize{ static_cast<unsigned int>(blockSize) }
+  , fBaselines{ std::move(baselines) }
+  , fRMS{ std::move(RMS) }
+{
+  if (fBlockSize == 0U) {
+    throw std::runtime_error
+      ("icarus::WaveformBaselineProfile: block size must be positive.");
+  }
+  if (fBaselines.size() != fRMS.size()) {
+    throw std::runtime_error("icarus::WaveformBaselineProfile: "
+      + std::to_string(fBaselines.size()) + " baselines but "
+      + std::to_string(fRMS.size()) + " RMS values.");
+  }
+} // icarus::WaveformBaselineProfile::WaveformBaselineProfile()
+
+
+//------------------------------------------------------------------------------
+icarus::WaveformBaseline icarus::WaveformBaselineProfile::average() const {
+  if (empty()) return {};
+  double sum = 0.0;
+  for (Baseline_t const baseline: fBaselines) sum += baseline;
+  return { static_cast<Baseline_t>(sum / nBlocks()) };
+} // icarus::WaveformBaselineProfile::average()
+
+
+//------------------------------------------------------------------------------
+std::ostream& icarus::operator<<
+  (std::ostream& out, icarus::WaveformBaselineProfile const& profile)
+{
+  out << profile.nBlocks() << " blocks of " << profile.blockSize()
+    << " samples";
+  if (!profile.empty()) out << ", average " << profile.average();
+  return out;
+} // icarus::operator<< (WaveformBaselineProfile)
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,147 @@
+/**
+ * @file   sbnobj/ICARUS/PMT/Data/WaveformBaselineProfile.h
+ * @brief  A baseline for a waveform, varying along the waveform.
+ * @see    sbnobj/ICARUS/PMT/Data/WaveformBaselineProfile.cxx
+ */
+ 
+#ifndef SBNOBJ_ICARUS_PMT_DATA_WAVEFORMBASELINEPROFILE_H
+#define SBNOBJ_ICARUS_PMT_DATA_WAVEFORMBASELINEPROFILE_H
+
+// ICARUS libraries
+#include "sbnobj/ICARUS/PMT/Data/WaveformBaseline.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <iosfwd> // std::ostream
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+namespace icarus {
+  
+  class WaveformBaselineProfile;
+  
+  /// Prints a summary of the baseline profile into a stream.
+  std::ostream& operator<<
+    (std::ostream& out, icarus::WaveformBaselineProfile const& profile);
+  
+} // namespace icarus
+
+/**
+ * @brief Piecewise baseline of a waveform, with its RMS.
+ * 
+ * The waveform is split in blocks of `blockSize()` consecutive samples (the
+ * last one may be shorter), and each block has its own baseline and RMS.
+ * The baseline at a sample (`at()`) is the one of the block the sample
+ * belongs to.
+ * 
+ * This object is usually created by `icarus::WaveformBaselineProfileBuilder`.
+ * 
+ * Example:
+ * ~~~~{.cpp}
+ * for (std::size_t i = 0; i < waveform.size(); ++i) {
+ *   float const signal = profile.at(i) - waveform[i]; // negative polarity
+ *   if (signal > 5.0f * profile.rmsAt(i)) { ... }
+ * }
+ * ~~~~
+ */
+class icarus::WaveformBaselineProfile {
+  
+    public:
+  
+  using Baseline_t = icarus::WaveformBaseline::Baseline_t;
+  
+  
+  /// Constructor: no blocks.
+  WaveformBaselineProfile() = default;
+  
+  /**
+   * @brief Constructor: sets all the content.
+   * @param blockSize number of samples in each block
+   * @param baselines the baseline of each block
+   * @param RMS the RMS of each block (as many as the baselines)
+   * @throw std::runtime_error if the sizes are not consistent
+   */
+  WaveformBaselineProfile(
+    std::size_t blockSize,
+    std::vector<Baseline_t> baselines, std::vector<Baseline_t> RMS
+    );
+  
+  
+  // --- BEGIN -- Access -------------------------------------------------------
+  /// @name Access
+  /// @{
+  
+  /// Returns whether there is no block.
+  bool empty() const { return fBaselines.empty(); }
+  
+  /// Returns the number of samples in each block.
+  std::size_t blockSize() const { return fBlockSize; }
+  
+  /// Returns the number of blocks.
+  std::size_t nBlocks() const { return fBaselines.size(); }
+  
+  /// Returns the number of the block including the specified sample.
+  std::size_t blockOf(std::size_t sampleIndex) const
+    { return sampleIndex / fBlockSize; }
+  
+  /// Returns the baseline of the specified block.
+  Baseline_t blockBaseline(std::size_t block) const
+    { return fBaselines[block]; }
+  
+  /// Returns the RMS of the specified block.
+  Baseline_t blockRMS(std::size_t block) const { return fRMS[block]; }
+  
+  /**
+   * @brief Returns the baseline at the specified sample.
+   * @param sampleIndex the index of the sample in the waveform
+   * @return the baseline of the block including the sample
+   * 
+   * Samples beyond the last block get the baseline of the last block.
+   * The profile must not be `empty()`.
+   */
+  Baseline_t at(std::size_t sampleIndex) const
+    { return fBaselines[clampedBlockOf(sampleIndex)]; }
+  
+  /// Returns the RMS of the baseline at the specified sample (see `at()`).
+  Baseline_t rmsAt(std::size_t sampleIndex) const
+    { return fRMS[clampedBlockOf(sampleIndex)]; }
+  
+  /// Returns the baseline at the specified sample (see `at()`).
+  Baseline_t operator() (std::size_t sampleIndex) const
+    { return at(sampleIndex); }
+  
+  /// Returns the baselines of all the blocks.
+  std::vector<Baseline_t> const& baselines() const { return fBaselines; }
+  
+  /// Returns the RMS of all the blocks.
+  std::vector<Baseline_t> const& RMS() const { return fRMS; }
+  
+  /// Returns the average baseline of all the blocks (`0` if `empty()`).
+  icarus::WaveformBaseline average() const;
+  
+  /// @}
+  // --- END ---- Access -------------------------------------------------------
+  
+  
+    private:
+  
+  unsigned int fBlockSize = 1U; ///< Number of samples in each block.
+  
+  std::vector<Baseline_t> fBaselines; ///< Baseline of each block.
+  
+  std::vector<Baseline_t> fRMS; ///< RMS of the baseline of each block.
+  
+  /// Returns the block of `sampleIndex`, or the last one if beyond it.
+  std::size_t clampedBlockOf(std::size_t sampleIndex) const
+    {
+      std::size_t const block = blockOf(sampleIndex);
+      return (block < nBlocks())? block: nBlocks() - 1U;
+    }
+  
+}; // icarus::WaveformBaselineProfile
+
+
+//------------------------------------------------------------------------------
+
+#endif // SBNOBJ_ICARUS_PMT_DATA_WAVEFORMBASELINEPROFILE_H
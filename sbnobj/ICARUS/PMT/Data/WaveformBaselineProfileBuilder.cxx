@@ -0,0 +1,101 @@
+/**
+ * @file   sbnobj/ICARUS/PMT/Data/WaveformBaselineProfileBuilder.cxx
+ * @brief  Computes the piecewise baseline of PMT waveforms.
+ * @see    sbnobj/ICARUS/PMT/Data/WaveformBaselineProfileBuilder.h
+ */
+
+// library header
+#include "sbnobj/ICARUS/PMT/Data/WaveformBaselineProfileBuilder.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::max(), std::min()
+#include <stdexcept> // std::runtime_error
+#include <utility> // std::move()
+#include <cmath> // std::sqrt(), std::abs()
+
+
+//------------------------------------------------------------------------------
+icarus::WaveformBaselineProfileBuilder::WaveformBaselineProfileBuilder()
+  : WaveformBaselineProfileBuilder(Config_t{})
+{}
+
+
+//------------------------------------------------------------------------------
+icarus::WaveformBaselineProfileBuilder::WaveformBaselineProfileBuilder
+  (Config_t config)
+  : fConfig{ config }
+{
+  if (fConfig.blockSize == 0U) {
+    throw std::runtime_error
+      ("icarus::WaveformBaselineProfileBuilder: block size must be positive.");
+  }
+} // icarus::WaveformBaselineProfileBuilder::WaveformBaselineProfileBuilder()
+
+
+//------------------------------------------------------------------------------
+auto icarus::WaveformBaselineProfileBuilder::operator()
+  (std::vector<raw::ADC_Count_t> const& samples) const
+  -> icarus::WaveformBaselineProfile
+{
+  std::size_t const blockSize = fConfig.blockSize;
+  std::size_t const nBlocks = (samples.size() + blockSize - 1U) / blockSize;
+  
+  std::vector<Baseline_t> baselines, RMS;
+  baselines.reserve(nBlocks);
+  RMS.reserve(nBlocks);
+  
+  bool const reject = fConfig.rejectionSigmas > 0.0f;
+  double maxDistance = 0.0; // from the previous baseline, if rejecting
+  
+  auto itSample = samples.begin();
+  for (std::size_t iBlock = 0U; iBlock < nBlocks; ++iBlock) {
+  
+    auto const blockEnd = samples.begin()
+      + std::min((iBlock + 1U) * blockSize, samples.size());
+    bool const useAll = !reject || baselines.empty();
+    double const reference = useAll? 0.0: baselines.back();
+    
+    // running mean and sum of squared deviations (Welford)
+    std::size_t n = 0U;
+    double mean = 0.0, sum2 = 0.0;
+    for (; itSample != blockEnd; ++itSample) {
+      double const value = *itSample;
+      if (!useAll && (std::abs(value - reference) > maxDistance)) continue;
+      double const delta = value - mean;
+      mean += delta / ++n;
+      sum2 += delta * (value - mean);
+    } // for samples
+    
+    if (n == 0U) { // all samples rejected: keep the previous values
+      Baseline_t const lastBaseline = baselines.back(), lastRMS = RMS.back();
+      baselines.push_back(lastBaseline);
+      RMS.push_back(lastRMS);
+    }
+    else {
+      baselines.push_back(static_cast<Baseline_t>(mean));
+      RMS.push_back(static_cast<Baseline_t>(std::sqrt(sum2 / n)));
+    }
+    
+    maxDistance = fConfig.rejectionSigmas
+      * std::max<double>(RMS.back(), fConfig.minRMS);
+  
+  } // for blocks
+  
+  return { blockSize, std::move(baselines), std::move(RMS) };
+} // icarus::WaveformBaselineProfileBuilder::operator()
+
+
+//------------------------------------------------------------------------------
+auto icarus::WaveformBaselineProfileBuilder::build
+  (std::vector<raw::OpDetWaveform> const& waveforms) const
+  -> std::vector<icarus::WaveformBaselineProfile>
+{
+  std::vector<icarus::WaveformBaselineProfile> profiles;
+  profiles.reserve(waveforms.size());
+  for (raw::OpDetWaveform const& waveform: waveforms)
+    profiles.push_back(this->operator() (waveform));
+  return profiles;
+} // icarus::WaveformBaselineProfileBuilder::build()
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,96 @@
+/**
+ * @file   sbnobj/ICARUS/PMT/Data/WaveformBaselineProfileBuilder.h
+ * @brief  Computes the piecewise baseline of PMT waveforms.
+ * @see    sbnobj/ICARUS/PMT/Data/WaveformBaselineProfileBuilder.cxx
+ */
+ 
+#ifndef SBNOBJ_ICARUS_PMT_DATA_WAVEFORMBASELINEPROFILEBUILDER_H
+#define SBNOBJ_ICARUS_PMT_DATA_WAVEFORMBASELINEPROFILEBUILDER_H
+
+// ICARUS libraries
+#include "sbnobj/ICARUS/PMT/Data/WaveformBaselineProfile.h"
+
+// LArSoft libraries
+#include "lardataobj/RawData/OpDetWaveform.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+namespace icarus { class WaveformBaselineProfileBuilder; }
+
+/**
+ * @brief Computes the piecewise baseline of waveforms.
+ * @see `icarus::WaveformBaselineProfile`
+ * 
+ * The waveform is processed in a single pass, in blocks of
+ * `Config_t::blockSize` samples. The baseline of each block is the average of
+ * its samples and the RMS is their standard deviation, both accumulated one
+ * sample at a time (Welford's algorithm).
+ * 
+ * If `Config_t::rejectionSigmas` is positive, the samples of a block farther
+ * from the baseline of the previous block than that many times its RMS (or
+ * `Config_t::minRMS`, whichever is larger) are excluded, so that signal pulses
+ * do not bias the baseline. A block whose samples are all excluded inherits
+ * the baseline and RMS of the previous block. The first block has no previous
+ * one and all its samples are used.
+ * 
+ * Example:
+ * ~~~~{.cpp}
+ * icarus::WaveformBaselineProfileBuilder const makeProfile{ { 250U, 3.0f } };
+ * 
+ * std::vector<icarus::WaveformBaselineProfile> const profiles
+ *   = makeProfile.build(waveforms);
+ * ~~~~
+ */
+class icarus::WaveformBaselineProfileBuilder {
+  
+    public:
+  
+  using Baseline_t = icarus::WaveformBaselineProfile::Baseline_t;
+  
+  /// Configuration of the algorithm.
+  struct Config_t {
+  
+    std::size_t blockSize = 500U; ///< Number of samples in each block.
+    
+    /// Samples farther than this many RMS from the previous baseline are
+    /// excluded (`0` to use all samples).
+    float rejectionSigmas = 0.0f;
+    
+    /// Minimum RMS used in the rejection of the samples [ADC counts].
+    float minRMS = 1.0f;
+  
+  }; // Config_t
+  
+  
+  /// Constructor: uses the default configuration.
+  WaveformBaselineProfileBuilder();
+  
+  /// Constructor: uses the specified configuration.
+  WaveformBaselineProfileBuilder(Config_t config);
+  
+  /// Returns the configuration of the algorithm.
+  Config_t const& config() const { return fConfig; }
+  
+  /// Returns the baseline profile of the specified waveform samples.
+  icarus::WaveformBaselineProfile operator()
+    (std::vector<raw::ADC_Count_t> const& samples) const;
+  
+  /// Returns the baseline profiles of all the `waveforms`, in the same order.
+  std::vector<icarus::WaveformBaselineProfile> build
+    (std::vector<raw::OpDetWaveform> const& waveforms) const;
+  
+  
+    private:
+  
+  Config_t fConfig; ///< Configuration.
+  
+}; // icarus::WaveformBaselineProfileBuilder
+
+
+//------------------------------------------------------------------------------
+
+#endif // SBNOBJ_ICARUS_PMT_DATA_WAVEFORMBASELINEPROFILEBUILDER_H
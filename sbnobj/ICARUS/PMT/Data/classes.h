@@ -7,12 +7,20 @@
  * 
  * * `icarus::WaveformBaseline`
  *   (and its associations with `raw::OpDetWaveform`)
+ * * `icarus::WaveformBaselineProfile`
+ *   (and its associations with `raw::OpDetWaveform`)
+ * * `icarus::CompactWaveformBaselines`
+ * * `icarus::ParallelCollectionInfo`
+ *   (replacing the associations of baselines with `raw::OpDetWaveform`)
  * 
  * See also `sbnobj/ICARUS/PMT/Data/classes_def.xml`.
  */
 
 // ICARUS libraries
 #include "sbnobj/ICARUS/PMT/Data/WaveformBaseline.h"
+#include "sbnobj/ICARUS/PMT/Data/WaveformBaselineProfile.h"
+#include "sbnobj/ICARUS/PMT/Data/CompactWaveformBaselines.h"
+#include "sbnobj/ICARUS/PMT/Data/ParallelCollectionInfo.h"
 
 // LArSoft libraries
 #include "lardataobj/RawData/OpDetWaveform.h"
@@ -0,0 +1,396 @@
+/**
+ * @file   sbnobj/ICARUS/PMT/Trigger/Data/AnchoredTriggerGateData.h
+ * @brief  A logical multilevel gate with ticks relative to a reference time.
+ * @see    `sbnobj/ICARUS/PMT/Trigger/Data/AnchoredTriggerGateData.tcc`
+ * 
+ * This is a header only library.
+ */
+ 
+#ifndef SBNOBJ_ICARUS_PMT_TRIGGER_DATA_ANCHOREDTRIGGERGATEDATA_H
+#define SBNOBJ_ICARUS_PMT_TRIGGER_DATA_ANCHOREDTRIGGERGATEDATA_H
+
+
+// ICARUS libraries
+#include "sbnobj/ICARUS/PMT/Trigger/Data/TriggerGateData.h"
+
+// C/C++ standard libraries
+#include <iosfwd> // std::ostream
+#include <limits>
+#include <utility> // std::pair, std::move()
+#include <type_traits> // std::is_signed_v, std::is_integral_v
+#include <cstdint> // std::int32_t
+
+
+//------------------------------------------------------------------------------
+namespace icarus::trigger {
+  
+  template
+    <typename Tick, typename TickInterval, typename RelativeTick = std::int32_t>
+  class AnchoredTriggerGateData;
+  
+  template <typename TK, typename TI, typename RT>
+  std::ostream& operator<<
+    (std::ostream&, AnchoredTriggerGateData<TK, TI, RT> const&);
+    
+} // namespace icarus::trigger
+
+
+//------------------------------------------------------------------------------
+/**
+ * @brief Logical multi-level gate with ticks relative to an anchor tick.
+ * @tparam Tick type used to count the ticks
+ * @tparam TickInterval type used to quantify tick difference
+ * @tparam RelativeTick signed integral type used to store the ticks
+ * @see `icarus::trigger::TriggerGateData`
+ * 
+ * This object describes the same multi-level gate as `TriggerGateData`, and
+ * offers the same queries and gate operations with ticks on the same time
+ * scale, `Tick`. The gate statuses are though stored as a
+ * `TriggerGateData<RelativeTick, RelativeTick>` gate (`relativeGate()`), with
+ * ticks relative to an anchor tick (`anchor()`), which makes each status half
+ * the size of one of `OpticalTriggerGateData_t` when using 32-bit relative
+ * ticks. This is viable when all the changes of the gate happen close to the
+ * anchor, as in the case of the gates within a single readout window anchored
+ * to the start of that window.
+ * 
+ * The ticks are converted on the fly: the gate can describe changes from
+ * `anchor() + MinRelativeTick` to `anchor() + MaxRelativeTick`, both excluded.
+ * Queries asking for ticks beyond that range behave as if asked about the
+ * closest end of the range, which makes no difference since the gate does not
+ * change there. Operations attempting to change the gate out of that range
+ * throw an exception instead. The special ticks `MinTick` and `MaxTick` are
+ * always accepted, and they are preserved through the conversion.
+ * 
+ * Gates with different anchors can be combined (e.g. `Sum()`): the result is
+ * anchored to the earliest of the two anchors, and the other gate is delayed
+ * by the difference of the anchors (or, better, the relative gate combination
+ * is performed with the delays which translate the two gates to that common
+ * anchor). All the changes of the combined gate must fit in the relative tick
+ * range of the new anchor. The anchor of a gate without changes is ignored.
+ * 
+ * Example: reduce the memory footprint of the discriminated gates in a readout
+ * window starting at `windowStart`:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * using AnchoredGate_t = icarus::trigger::AnchoredTriggerGateData
+ *   <icarus::trigger::TriggerGateTick_t, icarus::trigger::TriggerGateTicks_t>;
+ * 
+ * AnchoredGate_t const compactGate { gate, windowStart };
+ * if (compactGate.isOpen(windowStart + 100)) { ... }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * 
+ * @note With 16-bit relative ticks the range is much shorter, but the status
+ *       size is the same as with 32 bits because of the alignment of the
+ *       opening count.
+ */
+template <typename Tick, typename TickInterval, typename RelativeTick>
+class icarus::trigger::AnchoredTriggerGateData {
+  
+  static_assert(std::is_integral_v<Tick> && std::is_signed_v<Tick>,
+    "AnchoredTriggerGateData requires a signed integral tick type.");
+  static_assert
+    (std::is_integral_v<RelativeTick> && std::is_signed_v<RelativeTick>,
+    "AnchoredTriggerGateData requires a signed integral relative tick type.");
+  static_assert(sizeof(RelativeTick) <= sizeof(Tick),
+    "The relative tick type must not be larger than the tick type.");
+    
+    public:
+  
+  // --- BEGIN -- Data type definitions ----------------------------------------
+  /// This type.
+  using anchoredtriggergatedata_t
+    = AnchoredTriggerGateData<Tick, TickInterval, RelativeTick>;
+  
+  /// Type for gate tick.
+  using ClockTick_t = Tick;
+  
+  /// Type for gate ticks distance.
+  using ClockTicks_t = TickInterval;
+  
+  /// Type of the ticks stored in the gate, relative to the anchor.
+  using RelativeTick_t = RelativeTick;
+  
+  /// Type of the gate storing the relative ticks.
+  using RelativeGate_t = TriggerGateData<RelativeTick_t, RelativeTick_t>;
+  
+  /// Type of the equivalent gate with absolute ticks.
+  using GateData_t = TriggerGateData<ClockTick_t, ClockTicks_t>;
+  
+  /// Type for gate opening count.
+  using OpeningCount_t = typename RelativeGate_t::OpeningCount_t;
+  
+  /// Type for gate opening count difference.
+  using OpeningDiff_t = typename RelativeGate_t::OpeningDiff_t;
+  
+  // --- END -- Data type definitions ------------------------------------------
+  
+  
+  /// An unbearably small tick number.
+  static constexpr ClockTick_t MinTick = GateData_t::MinTick;
+  
+  /// An unbearably large tick number.
+  static constexpr ClockTick_t MaxTick = GateData_t::MaxTick;
+  
+  /// Relative tick representing `MinTick`.
+  static constexpr RelativeTick_t MinRelativeTick = RelativeGate_t::MinTick;
+  
+  /// Relative tick representing `MaxTick`.
+  static constexpr RelativeTick_t MaxRelativeTick = RelativeGate_t::MaxTick;
+  
+  
+  /**
+   * @brief Constructor: a closed gate anchored at the specified tick.
+   * @param anchor the tick relative ticks are measured from
+   * @throw std::runtime_error if relative ticks around `anchor` can't be
+   *        represented as `ClockTick_t`
+   */
+  explicit AnchoredTriggerGateData(ClockTick_t anchor = ClockTick_t{ 0 });
+  
+  /**
+   * @brief Constructor: copy of `gate`, anchored at the specified tick.
+   * @param gate the gate to be copied
+   * @param anchor the tick relative ticks are measured from
+   * @throw std::runtime_error if any change of `gate` can't be represented
+   *        relative to `anchor`
+   */
+  AnchoredTriggerGateData(GateData_t const& gate, ClockTick_t anchor);
+  
+  /// Returns a copy of `gate` anchored at its first change (or at tick `0`).
+  static anchoredtriggergatedata_t fromGate(GateData_t const& gate);
+  
+  
+  // --- BEGIN Query -----------------------------------------------------------
+  /// @name Query
+  /// @{
+  
+  /// Returns the tick the stored ticks are relative to.
+  ClockTick_t anchor() const { return fAnchor; }
+  
+  /// Returns the gate with the ticks relative to the anchor.
+  RelativeGate_t const& relativeGate() const { return fGate; }
+  
+  /// Returns whether `tick` can be the time of a change of this gate.
+  bool inRange(ClockTick_t tick) const;
+  
+  /// Returns whether the gate has any change after its start.
+  bool hasChanges() const { return fGate.lastTick() != MinRelativeTick; }
+  
+  /// Returns the tick of the last gate change (`MinTick` if none).
+  ClockTick_t lastTick() const { return toAbsolute(fGate.lastTick()); }
+  
+  /// Returns the opening count of the gate at the specified `tick`.
+  OpeningCount_t openingCount(ClockTick_t tick) const
+    { return fGate.openingCount(toRelative(tick)); }
+  
+  /// Returns whether this gate never opened.
+  bool alwaysClosed() const { return fGate.alwaysClosed(); }
+  
+  /// Returns whether the gate is open at all at the specified `tick`.
+  bool isOpen(ClockTick_t tick) const { return openingCount(tick) > 0U; }
+  
+  /// Returns the tick at which the gate opened.
+  /// @see `TriggerGateData::findOpen()`
+  ClockTick_t findOpen(
+    OpeningCount_t minOpening = 1U,
+    ClockTick_t start = MinTick, ClockTick_t end = MaxTick
+    ) const;
+  
+  /// Returns the tick at which the gate closed.
+  /// @see `TriggerGateData::findClose()`
+  ClockTick_t findClose(
+    OpeningCount_t minOpening = 1U,
+    ClockTick_t start = MinTick, ClockTick_t end = MaxTick
+    ) const;
+  
+  /// Returns the tick at which the gate has the maximum opening.
+  /// @see `TriggerGateData::findMaxOpen()`
+  ClockTick_t findMaxOpen
+    (ClockTick_t start = MinTick, ClockTick_t end = MaxTick) const;
+  
+  /// Returns the range of trigger opening values in the specified range.
+  /// @see `TriggerGateData::openingRange()`
+  std::pair<OpeningCount_t, OpeningCount_t> openingRange
+    (ClockTick_t start, ClockTick_t end) const
+    { return fGate.openingRange(toRelative(start), toRelativeBound(end)); }
+  
+  /// Returns a copy of this gate with absolute ticks.
+  GateData_t toGateData() const;
+  
+  /// @}
+  // --- END Query -------------------------------------------------------------
+  
+  
+  // --- BEGIN Gate opening and closing operations -----------------------------
+  /// @name Gate opening and closing operations
+  /// @{
+  ///
+  /// These operations behave like the ones of `TriggerGateData`, and they
+  /// throw `std::runtime_error` if any of the ticks is out of range.
+  ///
+  
+  /// Changes the opening to match `openingCount` at the specified time.
+  void setOpeningAt(ClockTick_t tick, OpeningCount_t openingCount)
+    { fGate.setOpeningAt(toRelativeOrThrow(tick), openingCount); }
+  
+  /// Open this gate at the specified time (increase the opening by `count`).
+  void openAt(ClockTick_t tick, OpeningDiff_t count = 1)
+    { fGate.openAt(toRelativeOrThrow(tick), count); }
+  
+  /// Open this gate at `start` tick, and close it at `end` tick.
+  void openBetween
+    (ClockTick_t start, ClockTick_t end, OpeningDiff_t count = 1)
+    {
+      fGate.openBetween
+        (toRelativeOrThrow(start), toRelativeOrThrow(end), count);
+    }
+  
+  /// Open this gate at specified `tick`, and close it `length` ticks later.
+  void openFor(ClockTick_t tick, ClockTicks_t length, OpeningDiff_t count = 1)
+    { openBetween(tick, tick + length, count); }
+  
+  /// Close this gate at the specified time (decrease the opening by `count`).
+  void closeAt(ClockTick_t tick, OpeningDiff_t count = 1)
+    { fGate.closeAt(toRelativeOrThrow(tick), count); }
+  
+  /// Sets the gate levels in the state at construction, keeping the anchor.
+  void clear() { fGate.clear(); }
+  
+  /// Removes the redundant statuses, if the gate may have any.
+  void compact() { fGate.compact(); }
+  
+  /// @}
+  // --- END Gate opening and closing operations -------------------------------
+  
+  
+  // --- BEGIN Combination operations ------------------------------------------
+  /// @name Combination operations
+  /// @{
+  ///
+  /// These operations behave like the ones of `TriggerGateData`.
+  /// The result is anchored at the earliest of the anchors of the two gates.
+  ///
+  
+  /// Combines with a gate, keeping the minimum opening among the two.
+  anchoredtriggergatedata_t& Min(anchoredtriggergatedata_t const& other)
+    { return *this = Min(*this, other); }
+  
+  /// Combines with a gate, keeping the maximum opening among the two.
+  anchoredtriggergatedata_t& Max(anchoredtriggergatedata_t const& other)
+    { return *this = Max(*this, other); }
+  
+  /// Combines with a gate, keeping the sum of openings of the two.
+  anchoredtriggergatedata_t& Sum(anchoredtriggergatedata_t const& other)
+    { return *this = Sum(*this, other); }
+  
+  /// Combines with a gate, keeping the product of openings of the two.
+  anchoredtriggergatedata_t& Mul(anchoredtriggergatedata_t const& other)
+    { return *this = Mul(*this, other); }
+  
+  /// Returns a gate with the minimum opening between the specified two.
+  static anchoredtriggergatedata_t Min
+    (anchoredtriggergatedata_t const& a, anchoredtriggergatedata_t const& b);
+  
+  /// Returns a gate with the maximum opening between the specified two.
+  static anchoredtriggergatedata_t Max
+    (anchoredtriggergatedata_t const& a, anchoredtriggergatedata_t const& b);
+  
+  /// Returns a gate with opening sum of the specified two.
+  static anchoredtriggergatedata_t Sum
+    (anchoredtriggergatedata_t const& a, anchoredtriggergatedata_t const& b);
+  
+  /// Returns a gate with opening product of the specified two.
+  static anchoredtriggergatedata_t Mul
+    (anchoredtriggergatedata_t const& a, anchoredtriggergatedata_t const& b);
+  
+  /**
+   * @brief Returns a gate combination of the openings of two other gates.
+   * @tparam Op binary operation: `OpeningCount_t` (x2) to `OpeningCount_t`
+   * @param op symmetric binary combination operation
+   * @param a first gate
+   * @param b second gate
+   * @param aDelay ticks of delay to be added to the first gate
+   * @param bDelay ticks of delay to be added to the second gate
+   * @return gate with opening combination of `a` and `b`
+   * @throw std::runtime_error if the combination does not fit the relative
+   *        tick range
+   * @see `TriggerGateData::SymmetricCombination()`
+   * 
+   * The result is anchored at the earliest of the delayed anchors of the two
+   * gates, and the relative gates are combined with the delays that bring
+   * them both to that anchor.
+   */
+  template <typename Op>
+  static anchoredtriggergatedata_t SymmetricCombination(
+    Op&& op,
+    anchoredtriggergatedata_t const& a, anchoredtriggergatedata_t const& b,
+    ClockTicks_t aDelay = ClockTicks_t{},
+    ClockTicks_t bDelay = ClockTicks_t{}
+    );
+  
+  /// @}
+  // --- END Combination operations --------------------------------------------
+  
+  
+  /// Comparison: same anchor and same relative gate.
+  bool operator== (AnchoredTriggerGateData const& other) const
+    { return (fAnchor == other.fAnchor) && (fGate == other.fGate); }
+  
+  /// Comparison: different anchor or different relative gate.
+  bool operator!= (AnchoredTriggerGateData const& other) const
+    { return !(*this == other); }
+    
+    
+    private:
+  
+  ClockTick_t fAnchor; ///< Tick the gate ticks are relative to.
+  
+  RelativeGate_t fGate; ///< The gate, with ticks relative to the anchor.
+  
+  
+  /// Constructor: uses the specified gate and anchor directly.
+  AnchoredTriggerGateData(ClockTick_t anchor, RelativeGate_t&& gate);
+  
+  /// Returns `tick` relative to the anchor, clamped into the relative range.
+  RelativeTick_t toRelative(ClockTick_t tick) const;
+  
+  /// Returns `tick` relative to the anchor as a boundary of a tick range.
+  /// Unlike `toRelative()`, ticks before the range but later than `MinTick`
+  /// are moved after the first status, which they would otherwise include.
+  RelativeTick_t toRelativeBound(ClockTick_t tick) const;
+  
+  /// Returns `tick` relative to the anchor.
+  /// @throw std::runtime_error if `tick` is out of range
+  RelativeTick_t toRelativeOrThrow(ClockTick_t tick) const;
+  
+  /// Returns the absolute tick corresponding to the relative `tick`.
+  ClockTick_t toAbsolute(RelativeTick_t tick) const;
+  
+  /// Converts a query result `tick` into absolute, mapping `relEnd` to `end`.
+  ClockTick_t toAbsoluteResult
+    (RelativeTick_t tick, RelativeTick_t relEnd, ClockTick_t end) const
+    { return (tick == relEnd)? end: toAbsolute(tick); }
+  
+  /// Returns whether `anchor` leaves the whole relative range representable.
+  static bool isValidAnchor(ClockTick_t anchor);
+  
+  /// Throws an exception if `anchor` is not valid.
+  static void checkAnchor(ClockTick_t anchor);
+  
+  /// Returns the delay moving `gate` from `gateAnchor` to `anchor`
+  /// (`0` if the gate has no change).
+  /// @throw std::runtime_error if the delayed gate does not fit
+  static RelativeTick_t relativeDelay
+    (RelativeGate_t const& gate, ClockTick_t gateAnchor, ClockTick_t anchor);
+  
+}; // class icarus::trigger::AnchoredTriggerGateData<>
+
+
+//------------------------------------------------------------------------------
+//--- Template implementation
+//------------------------------------------------------------------------------
+
+#include "sbnobj/ICARUS/PMT/Trigger/Data/AnchoredTriggerGateData.tcc"
+
+//------------------------------------------------------------------------------
+
+
+#endif // SBNOBJ_ICARUS_PMT_TRIGGER_DATA_ANCHOREDTRIGGERGATEDATA_H
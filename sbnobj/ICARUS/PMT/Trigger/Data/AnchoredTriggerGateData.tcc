@@ -0,0 +1,334 @@
+/**
+ * @file   sbnobj/ICARUS/PMT/Trigger/Data/AnchoredTriggerGateData.tcc
+ * @brief  A logical multilevel gate with ticks relative to a reference time.
+ * @see    sbnobj/ICARUS/PMT/Trigger/Data/AnchoredTriggerGateData.h
+ */
+ 
+#ifndef SBNOBJ_ICARUS_PMT_TRIGGER_DATA_ANCHOREDTRIGGERGATEDATA_TCC
+#define SBNOBJ_ICARUS_PMT_TRIGGER_DATA_ANCHOREDTRIGGERGATEDATA_TCC
+
+// LArSoft libraries
+#include "larcorealg/CoreUtils/StdUtils.h" // util::to_string()
+
+// C/C++ standard libraries
+#include <ostream>
+#include <stdexcept> // std::runtime_error
+#include <algorithm> // std::min()
+#include <functional> // std::plus<>, std::multiplies<>
+#include <utility> // std::forward(), std::move()
+
+
+// make "sure" this header is not included directly
+#ifndef SBNOBJ_ICARUS_PMT_TRIGGER_DATA_ANCHOREDTRIGGERGATEDATA_H
+# error "AnchoredTriggerGateData.tcc must not be directly included!"\
+        " #include \"sbnobj/ICARUS/PMT/Trigger/Data/AnchoredTriggerGateData.h\" instead."
+#endif // !SBNOBJ_ICARUS_PMT_TRIGGER_DATA_ANCHOREDTRIGGERGATEDATA_H
+
+
+//------------------------------------------------------------------------------
+//--- icarus::trigger::AnchoredTriggerGateData<>
+//------------------------------------------------------------------------------
+template <typename TK, typename TI, typename RT>
+icarus::trigger::AnchoredTriggerGateData<TK, TI, RT>::AnchoredTriggerGateData
+  (ClockTick_t anchor /* = 0 */)
+  : fAnchor(anchor)
+{
+  checkAnchor(fAnchor);
+} // icarus::trigger::AnchoredTriggerGateData<>::AnchoredTriggerGateData()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI, typename RT>
+icarus::trigger::AnchoredTriggerGateData<TK, TI, RT>::AnchoredTriggerGateData
+  (GateData_t const& gate, ClockTick_t anchor)
+  : AnchoredTriggerGateData(anchor)
+{
+  // statuses are copied as they are, since their event type matters too
+  typename RelativeGate_t::GateEvolution_t levels;
+  levels.reserve(gate.fGateLevel.size());
+  for (auto const& status: gate.fGateLevel) {
+    levels.emplace_back
+      (status.event, toRelativeOrThrow(status.tick), status.opening);
+  }
+  fGate = RelativeGate_t{ std::move(levels) };
+} // icarus::trigger::AnchoredTriggerGateData<>::AnchoredTriggerGateData(gate)
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI, typename RT>
+icarus::trigger::AnchoredTriggerGateData<TK, TI, RT>::AnchoredTriggerGateData
+  (ClockTick_t anchor, RelativeGate_t&& gate)
+  : fAnchor(anchor), fGate(std::move(gate))
+{
+  checkAnchor(fAnchor);
+} // icarus::trigger::AnchoredTriggerGateData<>::AnchoredTriggerGateData()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI, typename RT>
+auto icarus::trigger::AnchoredTriggerGateData<TK, TI, RT>::fromGate
+  (GateData_t const& gate) -> anchoredtriggergatedata_t
+{
+  // the first status is the start of the gate, not a change
+  ClockTick_t const anchor = (gate.fGateLevel.size() > 1U)
+    ? gate.fGateLevel[1U].tick: ClockTick_t{ 0 };
+  return { gate, anchor };
+} // icarus::trigger::AnchoredTriggerGateData<>::fromGate()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI, typename RT>
+bool icarus::trigger::AnchoredTriggerGateData<TK, TI, RT>::inRange
+  (ClockTick_t tick) const
+{
+  return (tick == MinTick) || (tick == MaxTick) || (
+    (tick > fAnchor + ClockTick_t{ MinRelativeTick })
+    && (tick < fAnchor + ClockTick_t{ MaxRelativeTick })
+    );
+} // icarus::trigger::AnchoredTriggerGateData<>::inRange()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI, typename RT>
+auto icarus::trigger::AnchoredTriggerGateData<TK, TI, RT>::findOpen(
+  OpeningCount_t minOpening /* = 1U */,
+  ClockTick_t start /* = MinTick */, ClockTick_t end /* = MaxTick */
+) const -> ClockTick_t
+{
+  RelativeTick_t const relEnd = toRelativeBound(end);
+  return toAbsoluteResult
+    (fGate.findOpen(minOpening, toRelativeBound(start), relEnd), relEnd, end);
+} // icarus::trigger::AnchoredTriggerGateData<>::findOpen()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI, typename RT>
+auto icarus::trigger::AnchoredTriggerGateData<TK, TI, RT>::findClose(
+  OpeningCount_t minOpening /* = 1U */,
+  ClockTick_t start /* = MinTick */, ClockTick_t end /* = MaxTick */
+) const -> ClockTick_t
+{
+  RelativeTick_t const relEnd = toRelativeBound(end);
+  return toAbsoluteResult
+    (fGate.findClose(minOpening, toRelativeBound(start), relEnd), relEnd, end);
+} // icarus::trigger::AnchoredTriggerGateData<>::findClose()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI, typename RT>
+auto icarus::trigger::AnchoredTriggerGateData<TK, TI, RT>::findMaxOpen
+  (ClockTick_t start /* = MinTick */, ClockTick_t end /* = MaxTick */) const
+  -> ClockTick_t
+{
+  RelativeTick_t const relStart = toRelativeBound(start);
+  RelativeTick_t const relEnd = toRelativeBound(end);
+  RelativeTick_t const relTick = fGate.findMaxOpen(relStart, relEnd);
+  // the relative result is never earlier than the (relative) start
+  return (relTick == relStart)? start: toAbsoluteResult(relTick, relEnd, end);
+} // icarus::trigger::AnchoredTriggerGateData<>::findMaxOpen()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI, typename RT>
+auto icarus::trigger::AnchoredTriggerGateData<TK, TI, RT>::toGateData() const
+  -> GateData_t
+{
+  typename GateData_t::GateEvolution_t levels;
+  levels.reserve(fGate.fGateLevel.size());
+  for (auto const& status: fGate.fGateLevel)
+    levels.emplace_back(status.event, toAbsolute(status.tick), status.opening);
+  return GateData_t{ std::move(levels) };
+} // icarus::trigger::AnchoredTriggerGateData<>::toGateData()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI, typename RT>
+auto icarus::trigger::AnchoredTriggerGateData<TK, TI, RT>::Min
+  (anchoredtriggergatedata_t const& a, anchoredtriggergatedata_t const& b)
+  -> anchoredtriggergatedata_t
+{
+  return SymmetricCombination
+    ([](OpeningCount_t a, OpeningCount_t b){ return std::min(a, b); }, a, b);
+} // icarus::trigger::AnchoredTriggerGateData<>::Min()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI, typename RT>
+auto icarus::trigger::AnchoredTriggerGateData<TK, TI, RT>::Max
+  (anchoredtriggergatedata_t const& a, anchoredtriggergatedata_t const& b)
+  -> anchoredtriggergatedata_t
+{
+  return SymmetricCombination
+    ([](OpeningCount_t a, OpeningCount_t b){ return std::max(a, b); }, a, b);
+} // icarus::trigger::AnchoredTriggerGateData<>::Max()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI, typename RT>
+auto icarus::trigger::AnchoredTriggerGateData<TK, TI, RT>::Sum
+  (anchoredtriggergatedata_t const& a, anchoredtriggergatedata_t const& b)
+  -> anchoredtriggergatedata_t
+{
+  return SymmetricCombination(std::plus<OpeningCount_t>(), a, b);
+} // icarus::trigger::AnchoredTriggerGateData<>::Sum()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI, typename RT>
+auto icarus::trigger::AnchoredTriggerGateData<TK, TI, RT>::Mul
+  (anchoredtriggergatedata_t const& a, anchoredtriggergatedata_t const& b)
+  -> anchoredtriggergatedata_t
+{
+  return SymmetricCombination(std::multiplies<OpeningCount_t>(), a, b);
+} // icarus::trigger::AnchoredTriggerGateData<>::Mul()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI, typename RT>
+template <typename Op>
+auto icarus::trigger::AnchoredTriggerGateData<TK, TI, RT>::SymmetricCombination(
+  Op&& op,
+  anchoredtriggergatedata_t const& a, anchoredtriggergatedata_t const& b,
+  ClockTicks_t aDelay /* = {} */, ClockTicks_t bDelay /* = {} */
+) -> anchoredtriggergatedata_t {
+  /*
+   * Both gates are moved to the earliest of their (delayed) anchors, which
+   * translates into a non-negative delay of the relative ticks of each of
+   * them; then the relative gates are combined with those delays.
+   * A gate which never changes does not need to be moved at all, and its
+   * anchor is ignored.
+   */
+  ClockTick_t const aAnchor = a.fAnchor + aDelay;
+  ClockTick_t const bAnchor = b.fAnchor + bDelay;
+  ClockTick_t anchor = std::min(aAnchor, bAnchor);
+  if (!a.hasChanges()) anchor = bAnchor;
+  else if (!b.hasChanges()) anchor = aAnchor;
+  checkAnchor(anchor);
+  
+  return {
+    anchor,
+    RelativeGate_t::SymmetricCombination(
+      std::forward<Op>(op), a.fGate, b.fGate,
+      relativeDelay(a.fGate, aAnchor, anchor),
+      relativeDelay(b.fGate, bAnchor, anchor)
+      )
+    };
+    
+} // icarus::trigger::AnchoredTriggerGateData<>::SymmetricCombination()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI, typename RT>
+auto icarus::trigger::AnchoredTriggerGateData<TK, TI, RT>::toRelative
+  (ClockTick_t tick) const -> RelativeTick_t
+{
+  if (tick <= fAnchor + ClockTick_t{ MinRelativeTick }) return MinRelativeTick;
+  if (tick >= fAnchor + ClockTick_t{ MaxRelativeTick }) return MaxRelativeTick;
+  return static_cast<RelativeTick_t>(tick - fAnchor);
+} // icarus::trigger::AnchoredTriggerGateData<>::toRelative()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI, typename RT>
+auto icarus::trigger::AnchoredTriggerGateData<TK, TI, RT>::toRelativeBound
+  (ClockTick_t tick) const -> RelativeTick_t
+{
+  RelativeTick_t const relTick = toRelative(tick);
+  return ((relTick == MinRelativeTick) && (tick != MinTick))
+    ? MinRelativeTick + 1: relTick;
+} // icarus::trigger::AnchoredTriggerGateData<>::toRelativeBound()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI, typename RT>
+auto icarus::trigger::AnchoredTriggerGateData<TK, TI, RT>::toRelativeOrThrow
+  (ClockTick_t tick) const -> RelativeTick_t
+{
+  if (tick == MinTick) return MinRelativeTick;
+  if (tick == MaxTick) return MaxRelativeTick;
+  if (!inRange(tick)) {
+    throw std::runtime_error(
+      "icarus::trigger::AnchoredTriggerGateData: requested time "
+      + util::to_string(tick) + " is too far from the gate anchor ("
+      + util::to_string(fAnchor) + ")"
+      );
+  }
+  return static_cast<RelativeTick_t>(tick - fAnchor);
+} // icarus::trigger::AnchoredTriggerGateData<>::toRelativeOrThrow()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI, typename RT>
+auto icarus::trigger::AnchoredTriggerGateData<TK, TI, RT>::toAbsolute
+  (RelativeTick_t tick) const -> ClockTick_t
+{
+  if (tick == MinRelativeTick) return MinTick;
+  if (tick == MaxRelativeTick) return MaxTick;
+  return fAnchor + ClockTick_t{ tick };
+} // icarus::trigger::AnchoredTriggerGateData<>::toAbsolute()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI, typename RT>
+bool icarus::trigger::AnchoredTriggerGateData<TK, TI, RT>::isValidAnchor
+  (ClockTick_t anchor)
+{
+  return (anchor >= MinTick - ClockTick_t{ MinRelativeTick })
+    && (anchor <= MaxTick - ClockTick_t{ MaxRelativeTick });
+} // icarus::trigger::AnchoredTriggerGateData<>::isValidAnchor()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI, typename RT>
+void icarus::trigger::AnchoredTriggerGateData<TK, TI, RT>::checkAnchor
+  (ClockTick_t anchor)
+{
+  if (isValidAnchor(anchor)) return;
+  throw std::runtime_error(
+    "icarus::trigger::AnchoredTriggerGateData: anchor time "
+    + util::to_string(anchor) + " is too close to the limits of the tick type"
+    );
+} // icarus::trigger::AnchoredTriggerGateData<>::checkAnchor()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI, typename RT>
+auto icarus::trigger::AnchoredTriggerGateData<TK, TI, RT>::relativeDelay
+  (RelativeGate_t const& gate, ClockTick_t gateAnchor, ClockTick_t anchor)
+  -> RelativeTick_t
+{
+  RelativeTick_t const lastTick = gate.lastTick(); // `MinTick` if no change
+  if (lastTick == MinRelativeTick) return RelativeTick_t{ 0 };
+  
+  // the new anchor is never later than the gate one
+  ClockTick_t const delay = gateAnchor - anchor;
+  bool const fits = (delay < ClockTick_t{ MaxRelativeTick })
+    && (ClockTick_t{ lastTick } < ClockTick_t{ MaxRelativeTick } - delay);
+  if (!fits) {
+    throw std::runtime_error(
+      "icarus::trigger::AnchoredTriggerGateData: gate anchored at "
+      + util::to_string(gateAnchor) + " can't be combined at anchor "
+      + util::to_string(anchor) + " (last change "
+      + util::to_string(lastTick) + " ticks from its anchor)"
+      );
+  }
+  return static_cast<RelativeTick_t>(delay);
+} // icarus::trigger::AnchoredTriggerGateData<>::relativeDelay()
+
+
+//------------------------------------------------------------------------------
+//--- output functions
+//------------------------------------------------------------------------------
+template <typename TK, typename TI, typename RT>
+std::ostream& icarus::trigger::operator<< (
+  std::ostream& out,
+  icarus::trigger::AnchoredTriggerGateData<TK, TI, RT> const& gate
+) {
+  out << gate.toGateData() << " (anchored at " << gate.anchor() << ")";
+  return out;
+} // icarus::trigger::operator<< (icarus::trigger::AnchoredTriggerGateData)
+
+
+//------------------------------------------------------------------------------
+
+#endif // SBNOBJ_ICARUS_PMT_TRIGGER_DATA_ANCHOREDTRIGGERGATEDATA_TCC
@@ -0,0 +1,185 @@
+/**
+ * @file   sbnobj/ICARUS/PMT/Trigger/Data/LVDSemulation.cxx
+ * @brief  Emulation of the LVDS trigger bits from trigger gates.
+ * @see    `sbnobj/ICARUS/PMT/Trigger/Data/LVDSemulation.h`
+ * 
+ */
+
+// library header
+#include "sbnobj/ICARUS/PMT/Trigger/Data/LVDSemulation.h"
+
+// C/C++ standard libraries
+#include <stdexcept> // std::out_of_range, std::invalid_argument
+#include <bitset>
+#include <iomanip> // std::setw(), std::setfill()
+
+
+//------------------------------------------------------------------------------
+//--- icarus::trigger::LVDSchannelMap
+//------------------------------------------------------------------------------
+void icarus::trigger::LVDSchannelMap::setBit(
+  ChannelID_t channel, std::size_t cryostat, std::size_t wall, std::size_t bit
+) {
+  if (cryostat >= LVDSmaxCryostats) {
+    throw std::out_of_range("icarus::trigger::LVDSchannelMap: cryostat index "
+      + std::to_string(cryostat) + " out of range");
+  }
+  if (wall >= LVDSmaxWalls) {
+    throw std::out_of_range("icarus::trigger::LVDSchannelMap: PMT wall index "
+      + std::to_string(wall) + " out of range");
+  }
+  if (bit >= LVDSwordBits) {
+    throw std::out_of_range("icarus::trigger::LVDSchannelMap: bit index "
+      + std::to_string(bit) + " out of range");
+  }
+  
+  if (channel >= fBits.size()) fBits.resize(channel + 1U);
+  BitLocation& location = fBits[channel];
+  if (!location.isValid()) ++fNAssigned;
+  location = BitLocation{
+    static_cast<std::uint8_t>(cryostat),
+    static_cast<std::uint8_t>(wall),
+    static_cast<std::uint8_t>(bit)
+    };
+    
+} // icarus::trigger::LVDSchannelMap::setBit()
+
+
+//------------------------------------------------------------------------------
+//--- icarus::trigger::LVDSmismatchStats
+//------------------------------------------------------------------------------
+void icarus::trigger::LVDSmismatchStats::add
+  (LVDSstatus_t const& emulated, LVDSstatus_t const& hardware)
+{
+  std::size_t nMismatchedBits = 0U;
+  for (std::size_t iCryo = 0U; iCryo < LVDSmaxCryostats; ++iCryo) {
+    for (std::size_t iWall = 0U; iWall < LVDSmaxWalls; ++iWall) {
+    
+      std::uint64_t const emul = emulated[iCryo][iWall];
+      std::uint64_t const hw = hardware[iCryo][iWall];
+      std::uint64_t const diff = emul ^ hw;
+      
+      WallCounts_t& counts = fWalls[iCryo][iWall];
+      if (emul & hw) countBits(counts.bothSet, emul & hw);
+      if (diff == 0U) continue;
+      
+      nMismatchedBits += std::bitset<LVDSwordBits>{ diff }.count();
+      countBits(counts.emulatedOnly, diff & emul);
+      countBits(counts.hardwareOnly, diff & hw);
+    
+    } // for walls
+  } // for cryostats
+  
+  ++fNSamples;
+  if (nMismatchedBits > 0U) ++fNMismatchedSamples;
+  fNMismatchedBits += nMismatchedBits;
+  
+} // icarus::trigger::LVDSmismatchStats::add()
+
+
+//------------------------------------------------------------------------------
+auto icarus::trigger::LVDSmismatchStats::operator+=
+  (LVDSmismatchStats const& other) -> LVDSmismatchStats&
+{
+  for (std::size_t iCryo = 0U; iCryo < LVDSmaxCryostats; ++iCryo) {
+    for (std::size_t iWall = 0U; iWall < LVDSmaxWalls; ++iWall) {
+      WallCounts_t& counts = fWalls[iCryo][iWall];
+      WallCounts_t const& otherCounts = other.fWalls[iCryo][iWall];
+      addCounts(counts.emulatedOnly, otherCounts.emulatedOnly);
+      addCounts(counts.hardwareOnly, otherCounts.hardwareOnly);
+      addCounts(counts.bothSet, otherCounts.bothSet);
+    } // for walls
+  } // for cryostats
+  
+  fNSamples += other.fNSamples;
+  fNMismatchedSamples += other.fNMismatchedSamples;
+  fNMismatchedBits += other.fNMismatchedBits;
+  return *this;
+} // icarus::trigger::LVDSmismatchStats::operator+=()
+
+
+//------------------------------------------------------------------------------
+void icarus::trigger::LVDSmismatchStats::dump(
+  std::ostream& out,
+  std::string const& indent, std::string const& firstIndent
+) const {
+  
+  out << firstIndent << "LVDS comparison of " << fNSamples << " samples: "
+    << fNMismatchedSamples << " with mismatches, " << fNMismatchedBits
+    << " mismatched bits in total";
+  if (fNMismatchedBits == 0U) return;
+  
+  out << "; bits with mismatches (emulation only / hardware only / both):";
+  for (std::size_t iCryo = 0U; iCryo < LVDSmaxCryostats; ++iCryo) {
+    for (std::size_t iWall = 0U; iWall < LVDSmaxWalls; ++iWall) {
+      WallCounts_t const& counts = fWalls[iCryo][iWall];
+      for (std::size_t iBit = 0U; iBit < LVDSwordBits; ++iBit) {
+        if (counts.emulatedOnly[iBit] + counts.hardwareOnly[iBit] == 0U)
+          continue;
+        out << "\n" << indent << "  C:" << iCryo << " W:" << iWall
+          << " bit " << std::setw(2) << iBit << " (0x" << std::hex
+          << std::setfill('0') << std::setw(16) << (std::uint64_t{ 1 } << iBit)
+          << std::dec << std::setfill(' ') << "): "
+          << counts.emulatedOnly[iBit] << " / " << counts.hardwareOnly[iBit]
+          << " / " << counts.bothSet[iBit];
+      } // for bits
+    } // for walls
+  } // for cryostats
+  
+} // icarus::trigger::LVDSmismatchStats::dump()
+
+
+//------------------------------------------------------------------------------
+void icarus::trigger::LVDSmismatchStats::countBits
+  (BitCounts_t& counts, std::uint64_t bits)
+{
+  // branchless, so that the compiler can vectorize it
+  for (std::size_t iBit = 0U; iBit < LVDSwordBits; ++iBit)
+    counts[iBit] += static_cast<Count_t>((bits >> iBit) & 1U);
+} // icarus::trigger::LVDSmismatchStats::countBits()
+
+
+//------------------------------------------------------------------------------
+void icarus::trigger::LVDSmismatchStats::addCounts
+  (BitCounts_t& counts, BitCounts_t const& other)
+{
+  for (std::size_t iBit = 0U; iBit < LVDSwordBits; ++iBit)
+    counts[iBit] += other[iBit];
+} // icarus::trigger::LVDSmismatchStats::addCounts()
+
+
+//------------------------------------------------------------------------------
+//--- free functions
+//------------------------------------------------------------------------------
+void icarus::trigger::details::checkLVDSgateBits
+  (std::size_t nGates, std::size_t nBits, const char* caller)
+{
+  if (nGates == nBits) return;
+  throw std::invalid_argument("icarus::trigger::" + std::string{ caller }
+    + "(): " + std::to_string(nBits) + " gate bits for " + std::to_string(nGates)
+    + " gates (the bits must come from `LVDSchannelMap::gateBits()` on the same"
+    " gates)");
+} // icarus::trigger::details::checkLVDSgateBits()
+
+
+//------------------------------------------------------------------------------
+auto icarus::trigger::LVDSstatusOf(sbn::ExtraTriggerInfo const& info)
+  -> LVDSstatus_t
+{
+  LVDSstatus_t status;
+  for (std::size_t iCryo = 0U; iCryo < LVDSmaxCryostats; ++iCryo)
+    status[iCryo] = info.cryostats[iCryo].LVDSstatus;
+  return status;
+} // icarus::trigger::LVDSstatusOf()
+
+
+//------------------------------------------------------------------------------
+std::ostream& icarus::trigger::operator<<
+  (std::ostream& out, LVDSmismatchStats const& stats)
+{
+  stats.dump(out);
+  return out;
+} // icarus::trigger::operator<< (LVDSmismatchStats)
+
+
+//------------------------------------------------------------------------------
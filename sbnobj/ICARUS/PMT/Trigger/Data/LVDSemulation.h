@@ -0,0 +1,409 @@
+/**
+ * @file   sbnobj/ICARUS/PMT/Trigger/Data/LVDSemulation.h
+ * @brief  Emulation of the LVDS trigger bits from trigger gates.
+ * @see    `sbnobj/ICARUS/PMT/Trigger/Data/LVDSemulation.cxx`
+ * 
+ */
+ 
+#ifndef SBNOBJ_ICARUS_PMT_TRIGGER_DATA_LVDSEMULATION_H
+#define SBNOBJ_ICARUS_PMT_TRIGGER_DATA_LVDSEMULATION_H
+
+
+// SBN libraries
+#include "sbnobj/Common/Trigger/ExtraTriggerInfo.h"
+
+// LArSoft libraries
+#include "lardataobj/RawData/OpDetWaveform.h" // raw::Channel_t
+
+// C/C++ standard libraries
+#include <ostream>
+#include <string>
+#include <vector>
+#include <array>
+#include <limits>
+#include <iterator> // std::size()
+#include <cstdint> // std::uint64_t, std::uint8_t
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+namespace icarus::trigger {
+  
+  /// Maximum number of cryostats with LVDS information.
+  inline constexpr std::size_t LVDSmaxCryostats
+    = sbn::ExtraTriggerInfo::MaxCryostats;
+  
+  /// Maximum number of PMT walls with LVDS information in each cryostat.
+  inline constexpr std::size_t LVDSmaxWalls = sbn::ExtraTriggerInfo::MaxWalls;
+  
+  /// Number of bits in a LVDS status word.
+  inline constexpr std::size_t LVDSwordBits = 64U;
+  
+  /// LVDS status words of a whole detector, by cryostat and by PMT wall.
+  /// The layout is the same as in `sbn::ExtraTriggerInfo::CryostatInfo`.
+  using LVDSstatus_t = std::array
+    <std::array<std::uint64_t, LVDSmaxWalls>, LVDSmaxCryostats>;
+  
+  class LVDSchannelMap;
+  class LVDSmismatchStats;
+  
+  /// Returns the LVDS status words recorded by the hardware in `info`.
+  LVDSstatus_t LVDSstatusOf(sbn::ExtraTriggerInfo const& info);
+  
+  /// Prints the mismatch statistics into `out`.
+  std::ostream& operator<< (std::ostream& out, LVDSmismatchStats const& stats);
+  
+} // namespace icarus::trigger
+
+
+//------------------------------------------------------------------------------
+/**
+ * @brief Assignment of optical channels to LVDS bits.
+ * 
+ * Each channel may be assigned to a bit of a LVDS status word of a PMT wall
+ * of a cryostat (see `sbn::ExtraTriggerInfo::CryostatInfo::LVDSstatus` for
+ * the bit layout). The lookup from a channel is a direct array access.
+ * 
+ * A trigger gate is assigned the bit of the first of its channels which has
+ * one. Since a collection of gates is usually sampled many times, the bits
+ * of all its gates may be resolved once with `gateBits()`.
+ */
+class icarus::trigger::LVDSchannelMap {
+  
+    public:
+  
+  /// Type of channel ID.
+  using ChannelID_t = raw::Channel_t;
+  
+  /// Location of a bit in the LVDS status words.
+  struct BitLocation {
+  
+    /// Value for an invalid index.
+    static constexpr std::uint8_t NoIndex
+      = std::numeric_limits<std::uint8_t>::max();
+    
+    std::uint8_t cryostat = NoIndex; ///< Cryostat index.
+    std::uint8_t wall = NoIndex; ///< PMT wall index within the cryostat.
+    std::uint8_t bit = NoIndex; ///< Bit index within the status word.
+    
+    /// Returns whether this location is assigned.
+    bool isValid() const { return cryostat != NoIndex; }
+    
+    /// Returns the mask of the bit within its status word.
+    std::uint64_t mask() const { return std::uint64_t{ 1 } << bit; }
+  
+  }; // BitLocation
+  
+  
+  /**
+   * @brief Assigns a LVDS bit to the specified `channel`.
+   * @param channel the channel to be assigned
+   * @param cryostat index of the cryostat
+   * @param wall index of the PMT wall within the cryostat
+   * @param bit index of the bit in the status word (`0` is least significant)
+   * @throw std::out_of_range if any of the indices is out of range
+   */
+  void setBit(
+    ChannelID_t channel,
+    std::size_t cryostat, std::size_t wall, std::size_t bit
+    );
+  
+  /// Returns the bit of `channel`, invalid if not assigned.
+  BitLocation bitOf(ChannelID_t channel) const
+    { return (channel < fBits.size())? fBits[channel]: BitLocation{}; }
+  
+  /// Returns the bit of the first channel of `gate` which has one.
+  template <typename Gate>
+  BitLocation bitOfGate(Gate const& gate) const;
+  
+  /// Returns the bit of each of the `gates`, in the same order.
+  template <typename Gates>
+  std::vector<BitLocation> gateBits(Gates const& gates) const;
+  
+  /// Returns the number of channels with an assigned bit.
+  std::size_t nAssigned() const { return fNAssigned; }
+  
+  
+    private:
+  
+  std::vector<BitLocation> fBits; ///< Bit of each channel, by channel ID.
+  
+  std::size_t fNAssigned = 0U; ///< Number of channels with a bit.
+  
+}; // icarus::trigger::LVDSchannelMap
+
+
+//------------------------------------------------------------------------------
+namespace icarus::trigger {
+  
+  /**
+   * @brief Returns the LVDS status words from the `gates` at `tick`.
+   * @tparam Gates type of collection of gates (like `OpticalTriggerGateData_t`)
+   * @param gates the gates to be sampled
+   * @param gateBits LVDS bit of each of the `gates` (same order)
+   * @param tick the tick to sample the gates at
+   * @param minOpening minimum opening count for the bit to be set
+   * @return all the LVDS status words
+   * @throw std::invalid_argument if `gateBits` and `gates` differ in size
+   * @see `LVDSchannelMap::gateBits()`
+   * 
+   * The bit of each gate is set if the gate has at least `minOpening` opening
+   * count at `tick`. Gates without a bit are ignored.
+   */
+  template <typename Gates>
+  LVDSstatus_t sampleLVDSstatusAt(
+    Gates const& gates,
+    std::vector<LVDSchannelMap::BitLocation> const& gateBits,
+    typename Gates::value_type::ClockTick_t tick, unsigned int minOpening = 1U
+    );
+  
+  /**
+   * @brief Returns the LVDS status words from the `gates` in a tick range.
+   * @tparam Gates type of collection of gates (like `OpticalTriggerGateData_t`)
+   * @param gates the gates to be sampled
+   * @param gateBits LVDS bit of each of the `gates` (same order)
+   * @param start the first tick of the range
+   * @param end the first tick after the range
+   * @param minOpening minimum opening count for the bit to be set
+   * @return all the LVDS status words
+   * @throw std::invalid_argument if `gateBits` and `gates` differ in size
+   * @see `sampleLVDSstatusAt()`
+   * 
+   * The bit of each gate is set if the gate has at least `minOpening` opening
+   * count at any tick between `start` and `end` (excluded).
+   */
+  template <typename Gates>
+  LVDSstatus_t sampleLVDSstatusIn(
+    Gates const& gates,
+    std::vector<LVDSchannelMap::BitLocation> const& gateBits,
+    typename Gates::value_type::ClockTick_t start,
+    typename Gates::value_type::ClockTick_t end,
+    unsigned int minOpening = 1U
+    );
+  
+  namespace details {
+    
+    /// Throws `std::invalid_argument` if there are not `nGates` gate bits.
+    void checkLVDSgateBits
+      (std::size_t nGates, std::size_t nBits, const char* caller);
+    
+  } // namespace details
+  
+} // namespace icarus::trigger
+
+
+//------------------------------------------------------------------------------
+/**
+ * @brief Statistics of disagreement between emulated and recorded LVDS bits.
+ * 
+ * Each call to `add()` compares one sample of the emulated LVDS status words
+ * against the ones recorded by the hardware (e.g. one per event), and updates
+ * for each bit the number of times it was found set only in the emulation,
+ * only in the hardware, or in both. The comparison of each status word is
+ * a few bitwise operations, and the per-bit counts are updated in loops the
+ * compiler can vectorize, so that a whole run can be processed in a single
+ * streaming pass.
+ * 
+ * Statistics collected separately (e.g. in different threads) can be merged
+ * with `operator+=`.
+ * 
+ * Example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * auto const bits = channelMap.gateBits(gates);
+ * stats.add(
+ *   icarus::trigger::sampleLVDSstatusAt(gates, bits, triggerTick),
+ *   icarus::trigger::LVDSstatusOf(extraTriggerInfo)
+ *   );
+ * // ... at the end of the run:
+ * std::cout << stats << std::endl;
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class icarus::trigger::LVDSmismatchStats {
+  
+    public:
+  
+  /// Type of counter.
+  using Count_t = unsigned int;
+  
+  /// Counters for each bit of a status word.
+  using BitCounts_t = std::array<Count_t, LVDSwordBits>;
+  
+  
+  /// Adds the comparison of the `emulated` status words with the `hardware`.
+  void add(LVDSstatus_t const& emulated, LVDSstatus_t const& hardware);
+  
+  /// Adds the comparison of the `emulated` status words with `info` ones.
+  void add(LVDSstatus_t const& emulated, sbn::ExtraTriggerInfo const& info)
+    { add(emulated, LVDSstatusOf(info)); }
+  
+  /// Adds the statistics from `other`.
+  LVDSmismatchStats& operator+= (LVDSmismatchStats const& other);
+  
+  /// Removes all the collected statistics.
+  void clear() { *this = LVDSmismatchStats{}; }
+  
+  
+  // --- BEGIN -- Access -------------------------------------------------------
+  /// @name Access
+  /// @{
+  
+  /// Returns the number of compared samples.
+  std::size_t nSamples() const { return fNSamples; }
+  
+  /// Returns the number of samples with at least one mismatching bit.
+  std::size_t nMismatchedSamples() const { return fNMismatchedSamples; }
+  
+  /// Returns the total number of mismatching bits in all the samples.
+  std::size_t nMismatchedBits() const { return fNMismatchedBits; }
+  
+  /// Returns how many times each bit was set only in the emulation.
+  BitCounts_t const& emulatedOnly(std::size_t cryostat, std::size_t wall) const
+    { return fWalls[cryostat][wall].emulatedOnly; }
+  
+  /// Returns how many times each bit was set only in the hardware.
+  BitCounts_t const& hardwareOnly(std::size_t cryostat, std::size_t wall) const
+    { return fWalls[cryostat][wall].hardwareOnly; }
+  
+  /// Returns how many times each bit was set both in emulation and hardware.
+  BitCounts_t const& bothSet(std::size_t cryostat, std::size_t wall) const
+    { return fWalls[cryostat][wall].bothSet; }
+  
+  /// Returns how many times the specified bit was different.
+  Count_t nMismatches
+    (std::size_t cryostat, std::size_t wall, std::size_t bit) const
+    {
+      return emulatedOnly(cryostat, wall)[bit]
+        + hardwareOnly(cryostat, wall)[bit];
+    }
+  
+  /// @}
+  // --- END ---- Access -------------------------------------------------------
+  
+  
+  /**
+   * @brief Prints the statistics into `out`.
+   * @param out the stream to print into
+   * @param indent indentation of all lines but the first
+   * @param firstIndent indentation of the first line
+   * 
+   * Only the bits with mismatches are listed.
+   */
+  void dump(
+    std::ostream& out,
+    std::string const& indent, std::string const& firstIndent
+    ) const;
+  
+  /// Prints the statistics into `out`.
+  void dump(std::ostream& out, std::string const& indent = "") const
+    { dump(out, indent, indent); }
+    
+    
+    private:
+  
+  /// Counters for one status word.
+  struct WallCounts_t {
+    BitCounts_t emulatedOnly {}; ///< Bits set only in the emulation.
+    BitCounts_t hardwareOnly {}; ///< Bits set only in the hardware.
+    BitCounts_t bothSet {}; ///< Bits set in both.
+  }; // WallCounts_t
+  
+  /// Counters for all status words.
+  std::array<std::array<WallCounts_t, LVDSmaxWalls>, LVDSmaxCryostats> fWalls;
+  
+  std::size_t fNSamples = 0U; ///< Number of compared samples.
+  std::size_t fNMismatchedSamples = 0U; ///< Samples with mismatching bits.
+  std::size_t fNMismatchedBits = 0U; ///< Total number of mismatching bits.
+  
+  /// Adds `1` to the count of each bit set in `bits`.
+  static void countBits(BitCounts_t& counts, std::uint64_t bits);
+  
+  /// Adds `other` counts to `counts`.
+  static void addCounts(BitCounts_t& counts, BitCounts_t const& other);
+  
+}; // icarus::trigger::LVDSmismatchStats
+
+
+//------------------------------------------------------------------------------
+//---  Template implementation
+//------------------------------------------------------------------------------
+template <typename Gate>
+auto icarus::trigger::LVDSchannelMap::bitOfGate(Gate const& gate) const
+  -> BitLocation
+{
+  for (ChannelID_t const channel: gate.channels()) {
+    if (BitLocation const bit = bitOf(channel); bit.isValid()) return bit;
+  }
+  return {};
+} // icarus::trigger::LVDSchannelMap::bitOfGate()
+
+
+//------------------------------------------------------------------------------
+template <typename Gates>
+auto icarus::trigger::LVDSchannelMap::gateBits(Gates const& gates) const
+  -> std::vector<BitLocation>
+{
+  std::vector<BitLocation> bits;
+  bits.reserve(std::size(gates));
+  for (auto const& gate: gates) bits.push_back(bitOfGate(gate));
+  return bits;
+} // icarus::trigger::LVDSchannelMap::gateBits()
+
+
+//------------------------------------------------------------------------------
+template <typename Gates>
+auto icarus::trigger::sampleLVDSstatusAt(
+  Gates const& gates,
+  std::vector<LVDSchannelMap::BitLocation> const& gateBits,
+  typename Gates::value_type::ClockTick_t tick,
+  unsigned int minOpening /* = 1U */
+) -> LVDSstatus_t
+{
+  details::checkLVDSgateBits
+    (std::size(gates), gateBits.size(), "sampleLVDSstatusAt");
+  
+  LVDSstatus_t status {};
+  auto iBit = gateBits.cbegin();
+  for (auto const& gate: gates) {
+    LVDSchannelMap::BitLocation const& bit = *(iBit++);
+    if (!bit.isValid()) continue;
+    if (gate.openingCount(tick) >= minOpening)
+      status[bit.cryostat][bit.wall] |= bit.mask();
+  } // for
+  return status;
+} // icarus::trigger::sampleLVDSstatusAt()
+
+
+//------------------------------------------------------------------------------
+template <typename Gates>
+auto icarus::trigger::sampleLVDSstatusIn(
+  Gates const& gates,
+  std::vector<LVDSchannelMap::BitLocation> const& gateBits,
+  typename Gates::value_type::ClockTick_t start,
+  typename Gates::value_type::ClockTick_t end,
+  unsigned int minOpening /* = 1U */
+) -> LVDSstatus_t
+{
+  details::checkLVDSgateBits
+    (std::size(gates), gateBits.size(), "sampleLVDSstatusIn");
+  
+  LVDSstatus_t status {};
+  if (start >= end) return status;
+  auto iBit = gateBits.cbegin();
+  for (auto const& gate: gates) {
+    LVDSchannelMap::BitLocation const& bit = *(iBit++);
+    if (!bit.isValid()) continue;
+    // open at start, or opening later before the end of the range
+    if ((gate.openingCount(start) >= minOpening)
+      || (gate.findOpen(minOpening, start, end) != end)
+    ) {
+      status[bit.cryostat][bit.wall] |= bit.mask();
+    }
+  } // for
+  return status;
+} // icarus::trigger::sampleLVDSstatusIn()
+
+
+//------------------------------------------------------------------------------
+
+
+#endif // SBNOBJ_ICARUS_PMT_TRIGGER_DATA_LVDSEMULATION_H
@@ -23,6 +23,7 @@
 #include <iosfwd> // std::ostream
 #include <vector>
 #include <utility> // std::move()
+#include <type_traits> // std::is_nothrow_move_constructible_v
 
 
 //------------------------------------------------------------------------------
@@ -271,6 +272,16 @@ class icarus::trigger::OpticalTriggerGate
 
 }; // class icarus::trigger::OpticalTriggerGate
 
+
+// gates must be moved, not copied, when a container of them grows
+static_assert(std::is_nothrow_move_constructible_v
+  <icarus::trigger::OpticalTriggerGate::GateData_t::GateData_t>);
+static_assert(std::is_nothrow_move_constructible_v
+  <icarus::trigger::OpticalTriggerGate::GateData_t>);
+static_assert
+  (std::is_nothrow_move_constructible_v<icarus::trigger::OpticalTriggerGate>);
+
+
 //------------------------------------------------------------------------------
 
 #endif // SBNOBJ_ICARUS_PMT_TRIGGER_DATA_OPTICALTRIGGERGATE_H
@@ -15,6 +15,9 @@
 #ifndef SBNOBJ_ICARUS_PMT_TRIGGER_DATA_TRIGGERGATEDATA_H
 #define SBNOBJ_ICARUS_PMT_TRIGGER_DATA_TRIGGERGATEDATA_H
 
+// ICARUS libraries
+#include "sbnobj/ICARUS/PMT/Trigger/Data/TriggerGateInstrumentation.h"
+
 // C/C++ standard libraries
 #include <vector>
 #include <iosfwd> // std::ostream
@@ -22,6 +25,9 @@
 #include <limits>
 #include <utility> // std::pair, std::move()
 #include <type_traits> // std::make_signed_t
+#include <atomic>
+#include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
 
 
 // --- BEGIN -- Preliminary declarations and definitions -----------------------
@@ -77,14 +83,86 @@ namespace icarus::trigger {
     }; // struct TriggerGateStatus
     
     
+    /// Returns whether gate compaction removes `status` following `lastKept`.
+    template <typename ClockTick, typename OpeningCount>
+    bool isRedundantGateStatus(
+      TriggerGateStatus<ClockTick, OpeningCount> const& lastKept,
+      TriggerGateStatus<ClockTick, OpeningCount> const& status
+      );
+    
+    
+    /**
+     * @brief Cache for the fingerprint of a gate.
+     * 
+     * The value is stored atomically, so that the fingerprint of a gate can be
+     * computed on demand also while the gate is shared among threads.
+     * Copies carry the cached value along, and so do moves, which leave the
+     * source without a cached value. None of them throws, so that the gates
+     * are moved rather than copied when their containers reallocate.
+     */
+    struct TriggerGateFingerprintCache {
+      
+      /// Value representing a fingerprint not computed yet.
+      static constexpr std::uint64_t NoFingerprint = 0U;
+      
+      std::atomic<std::uint64_t> value { NoFingerprint };
+      
+      TriggerGateFingerprintCache() = default;
+      TriggerGateFingerprintCache
+        (TriggerGateFingerprintCache const& other) noexcept
+        : value(other.load()) {}
+      TriggerGateFingerprintCache(TriggerGateFingerprintCache&& other) noexcept
+        : value(other.load()) { other.invalidate(); }
+      TriggerGateFingerprintCache& operator=
+        (TriggerGateFingerprintCache const& other) noexcept
+        { store(other.load()); return *this; }
+      TriggerGateFingerprintCache& operator=
+        (TriggerGateFingerprintCache&& other) noexcept
+        {
+          if (&other != this) { store(other.load()); other.invalidate(); }
+          return *this;
+        }
+      
+      /// Returns whether a fingerprint is cached.
+      bool valid() const noexcept { return load() != NoFingerprint; }
+      
+      /// Returns the cached fingerprint (`NoFingerprint` if none).
+      std::uint64_t load() const noexcept
+        { return value.load(std::memory_order_relaxed); }
+      
+      /// Sets the cached fingerprint.
+      void store(std::uint64_t fingerprint) noexcept
+        { value.store(fingerprint, std::memory_order_relaxed); }
+      
+      /// Forgets the cached fingerprint.
+      void invalidate() noexcept { store(NoFingerprint); }
+      
+    }; // struct TriggerGateFingerprintCache
+    
+    
   } // namespace details
   
+  
+  /// Outcome of the non-throwing gate operations.
+  enum class TriggerGateMutationStatus {
+    Success,         ///< The operation was completed.
+    TickBeforeGate,  ///< The requested tick precedes the start of the gate.
+    OpeningUnderflow ///< The opening would drop below `0` (debug builds only).
+  }; // TriggerGateMutationStatus
+  
+  
   //
   // declarations
   //
   template <typename Tick, typename TickInterval>
   class TriggerGateData;
   
+  template <typename Tick, typename OpeningCount = unsigned int>
+  class TriggerGateView;
+  
+  template <typename Tick, typename TickInterval, typename RelativeTick>
+  class AnchoredTriggerGateData;
+  
   
   template <typename TK, typename TI>
   std::ostream& operator<< (std::ostream&, TriggerGateData<TK, TI> const&);
@@ -127,6 +205,11 @@ namespace icarus::trigger {
  * opening event (that is an increase in level) and a closing one (a shift of
  * the same amount in the opposite direction).
  * 
+ * The operations `setOpeningAt()`, `openBetween()`, `openInIntervals()`,
+ * `compact()` and `SymmetricCombination()` (and their non-throwing versions)
+ * take as first template argument an instrumentation policy, which by default
+ * does not record anything (see `TriggerGateInstrumentation.h`).
+ * 
  */
 template <typename Tick, typename TickInterval>
 class icarus::trigger::TriggerGateData {
@@ -148,6 +231,12 @@ class icarus::trigger::TriggerGateData {
   /// Type representing a variation of open channels.
   using OpeningDiff_t = std::make_signed_t<OpeningCount_t>;
   
+  /// Type of outcome of the non-throwing gate operations.
+  using MutationStatus = TriggerGateMutationStatus;
+  
+  /// Type of read-only view of the gate statuses.
+  using GateView_t = TriggerGateView<ClockTick_t, OpeningCount_t>;
+  
   // --- END -- Data type definitions ------------------------------------------
   
   
@@ -245,6 +334,30 @@ class icarus::trigger::TriggerGateData {
   std::pair<OpeningCount_t, OpeningCount_t> openingRange
     (ClockTick_t start, ClockTick_t end) const;
   
+  /**
+   * @brief Returns a 64-bit fingerprint of the content of the gate.
+   * @see `hasFingerprint()`
+   * 
+   * The fingerprint is a hash of the gate statuses after compaction (that is,
+   * ignoring the statuses which `compact()` would remove), so that gates with
+   * different fingerprints are certainly different, while gates with the same
+   * fingerprint are very likely to have the same gate levels.
+   * 
+   * The value is computed on the first request and cached until the gate is
+   * changed.
+   */
+  std::uint64_t fingerprint() const;
+  
+  /// Returns whether the fingerprint is already computed and cached.
+  bool hasFingerprint() const { return fFingerprint.valid(); }
+  
+  /// Returns whether the gate may hold statuses removed by `compact()`.
+  bool mayNeedCompaction() const { return fMayNeedCompaction; }
+  
+  /// Returns a read-only view of the statuses of this gate.
+  /// @see `icarus::trigger::TriggerGateView`
+  GateView_t view() const;
+  
   // --- END Query -------------------------------------------------------------
   
   
@@ -253,6 +366,7 @@ class icarus::trigger::TriggerGateData {
   /// @{
   
   /// Changes the opening to match `openingCount` at the specified time.
+  template <typename Instr = instrumentation::NoRecording>
   void setOpeningAt(ClockTick_t tick, OpeningCount_t openingCount);
   
   /// Open this gate at the specified time (increase the opening by `count`).
@@ -263,12 +377,30 @@ class icarus::trigger::TriggerGateData {
   void openAt(ClockTick_t tick) { openAt(tick, 1); }
   
   /// Open this gate at specified `start` tick, and close it at `end` tick.
+  template <typename Instr = instrumentation::NoRecording>
   void openBetween(ClockTick_t start, ClockTick_t end, OpeningDiff_t count = 1);
   
   /// Open this gate at the specified time, and close it `length` ticks later.
   void openFor(ClockTick_t tick, ClockTicks_t length, OpeningDiff_t count = 1)
     { openBetween(tick, tick + length, count); }
 
+  /**
+   * @brief Opens this gate in each of the specified tick intervals.
+   * @tparam Instr instrumentation policy
+   * @tparam Intervals a sized collection of `{ start, end }` tick pairs
+   * @param intervals the list of intervals to open the gate in
+   * @param count (default: `1`) the opening increase in each interval
+   * @see `openBetween()`
+   *
+   * The result is the same as calling `openBetween()` on each interval in
+   * turn. Intervals which are sorted, not overlapping and start at or after
+   * `lastTick()`, as it happens when building a gate from a waveform, are
+   * appended directly at the end of the gate without any search or insertion.
+   */
+  template
+    <typename Instr = instrumentation::NoRecording, typename Intervals>
+  void openInIntervals(Intervals const& intervals, OpeningDiff_t count = 1);
+
   /// Close this gate at the specified time (decrease the opening by `count`).
   void closeAt(ClockTick_t tick, OpeningDiff_t count)
     { return openAt(tick, -count); }
@@ -280,7 +412,55 @@ class icarus::trigger::TriggerGateData {
   void closeAllAt(ClockTick_t tick) { setOpeningAt(tick, 0U); }
   
   /// Sets the gate levels in the state at construction.
-  void clear() { fGateLevel = startingGateLevel(); }
+  void clear() { fGateLevel = startingGateLevel(); contentChanged(); }
+  
+  /**
+   * @brief Removes the redundant statuses, if the gate may have any.
+   * @see `mayNeedCompaction()`
+   * 
+   * The gate operations may leave redundant statuses behind (like a shift to
+   * the same opening level as before): they are never removed automatically,
+   * so that the content of `gateLevels()` depends only on the operations
+   * performed on the gate. Producers should call this method before storing
+   * the gate. The gate keeps track of whether a compaction may be needed at
+   * all, so the call is cheap on a gate which is already compact.
+   * The levels of the gate and the result of the queries are not affected.
+   */
+  template <typename Instr = instrumentation::NoRecording>
+  void compact()
+    { if (fMayNeedCompaction) removeRedundantStatuses<Instr>(); }
+  
+  /**
+   * @brief Changes the opening to match `openingCount` at the specified time.
+   * @return `MutationStatus::Success`, or the reason of the failure
+   * @see `setOpeningAt()`
+   * 
+   * This is the non-throwing version of `setOpeningAt()`: if `tick` precedes
+   * the start of the gate, `MutationStatus::TickBeforeGate` is returned and
+   * the gate is left unchanged.
+   */
+  template <typename Instr = instrumentation::NoRecording>
+  MutationStatus setOpeningAtUnchecked
+    (ClockTick_t tick, OpeningCount_t openingCount);
+  
+  /**
+   * @brief Open this gate at `start` tick, and close it at `end` tick.
+   * @return `MutationStatus::Success`, or the reason of the failure
+   * @see `openBetween()`
+   * 
+   * This is the non-throwing version of `openBetween()`. A `start` tick
+   * preceding the start of the gate is always reported as
+   * `MutationStatus::TickBeforeGate`, leaving the gate unchanged.
+   * The check that closing the gate (negative `count`) does not bring its
+   * opening below `0` is instead performed only in debug builds (`NDEBUG` not
+   * defined), where a failure is reported as
+   * `MutationStatus::OpeningUnderflow` and leaves the gate partially changed,
+   * like the exception from `openBetween()` does. In optimized builds, it is
+   * the responsibility of the caller not to close more than it is open.
+   */
+  template <typename Instr = instrumentation::NoRecording>
+  MutationStatus openBetweenUnchecked
+    (ClockTick_t start, ClockTick_t end, OpeningDiff_t count = 1);
   
   /// @}
   // --- END Gate opening and closing operations -------------------------------
@@ -376,6 +556,7 @@ class icarus::trigger::TriggerGateData {
 
   /**
    * @brief Returns a gate combination of the openings of two other gates.
+   * @tparam Instr instrumentation policy
    * @tparam Op binary operation: `OpeningCount_t` (x2) to `OpeningCount_t`
    * @param op symmetric binary combination operation
    * @param a first gate
@@ -389,7 +570,7 @@ class icarus::trigger::TriggerGateData {
    * `c1` and `c2`.
    * 
    */
-  template <typename Op>
+  template <typename Instr = instrumentation::NoRecording, typename Op>
   static triggergatedata_t SymmetricCombination(
     Op&& op, triggergatedata_t const& a, triggergatedata_t const& b,
     ClockTicks_t aDelay = ClockTicks_t{},
@@ -401,8 +582,19 @@ class icarus::trigger::TriggerGateData {
   
 
   // standard comparison operators: all must be the same
+  // (gates with cached, different fingerprints are quickly found different)
   bool operator== (TriggerGateData const&) const;
   bool operator!= (TriggerGateData const&) const;
+  
+  /**
+   * @brief Returns whether `other` gate has the same statuses after compaction.
+   * @see `compact()`, `fingerprint()`
+   * 
+   * Unlike `operator==`, the statuses which `compact()` would remove are
+   * ignored, with the same semantics as `fingerprint()`: two gates differing
+   * only in redundant statuses are considered the same.
+   */
+  bool sameLevels(TriggerGateData const& other) const;
 
     protected:
   
@@ -423,6 +615,10 @@ class icarus::trigger::TriggerGateData {
   friend std::ostream& operator<< <ClockTick_t, ClockTicks_t>
     (std::ostream&, Status const&);
   
+  // the anchored gate converts the statuses between tick types one by one
+  template <typename, typename, typename>
+  friend class AnchoredTriggerGateData;
+  
   
     private:
   
@@ -447,9 +643,33 @@ class icarus::trigger::TriggerGateData {
   /// A new gate starts with this status: opening level set to 0.
   static Status const NewGateStatus;
   
+  /// Minimum number of unused allocated statuses before releasing them.
+  static constexpr std::size_t MinShrinkWaste = 16U;
+  
+  /// Whether the non-throwing operations check their preconditions.
+#ifdef NDEBUG
+  static constexpr bool CheckUncheckedPreconditions = false;
+#else // !NDEBUG
+  static constexpr bool CheckUncheckedPreconditions = true;
+#endif // NDEBUG
+  
   
   GateEvolution_t fGateLevel; ///< Evolution of the gate in time.
   
+  /// Cached fingerprint of the gate content (not persistent).
+  mutable details::TriggerGateFingerprintCache fFingerprint; //!
+  
+  /// Whether the gate may hold redundant statuses (not persistent).
+  bool fMayNeedCompaction = true; //!
+  
+  
+  /// Marks the gate content as changed, invalidating the cached information.
+  void contentChanged()
+    { fFingerprint.invalidate(); fMayNeedCompaction = true; }
+  
+  /// Replaces the content of this gate with the one of `other`.
+  void takeGateLevels(triggergatedata_t&& other);
+  
   
   /// Returns a const-iterator to the status current at `tick`, or no value.
   std::optional<status_const_iterator> findLastStatusFor
@@ -466,7 +686,33 @@ class icarus::trigger::TriggerGateData {
   /// @throw cet::exception if tick can't be handled
   status_const_iterator findLastStatusForTickOrThrow(ClockTick_t tick) const;
   
-  /// Returns an iterator to the first status for which `op(status)` is true.
+  /// Throws the exception for a `tick` before the start of the gate.
+  [[noreturn]] void throwTickBeforeGate(ClockTick_t tick) const;
+  
+  /// Throws the exception for closing more than open at `status`.
+  [[noreturn]] static void throwOpeningUnderflow
+    (ClockTick_t start, OpeningDiff_t count, Status const& status);
+  
+  /// Implementation of `setOpeningAt()` from the status current at `tick`.
+  template <typename Instr>
+  void setOpeningFrom
+    (status_iterator iStatus, ClockTick_t tick, OpeningCount_t openingCount);
+  
+  /**
+   * @brief Implementation of `openBetween()` from the status current at `start`.
+   * @tparam CheckUnderflow whether to check the opening does not drop below 0
+   * @tparam Instr instrumentation policy
+   * @param failed if not `nullptr`, receives the status which can't be closed
+   * @return `MutationStatus::Success` or `MutationStatus::OpeningUnderflow`
+   */
+  template <bool CheckUnderflow, typename Instr>
+  MutationStatus openBetweenFrom(
+    status_iterator iStatus, ClockTick_t start, ClockTick_t end,
+    OpeningDiff_t count, Status* failed = nullptr
+    );
+  
+  /// Returns an iterator to the first status for which `op(status)` is true,
+  /// ignoring the statuses which `compact()` would remove.
   template <typename Op>
   status_const_iterator findStatus
     (Op op, ClockTick_t start = MinTick, ClockTick_t end = MaxTick) const;
@@ -488,7 +734,17 @@ class icarus::trigger::TriggerGateData {
     (ClockTick_t start = MinTick, ClockTick_t end = MaxTick) const;
 
   /// Maintenance operation: removes unconsequential stati.
-  void compact();
+  template <typename Instr>
+  void removeRedundantStatuses();
+  
+  /// Returns whether `compact()` removes `status` following `lastKept` status.
+  static bool isRedundantStatus(Status const& lastKept, Status const& status);
+  
+  /// Releases the unused memory of `levels` if there is enough of it.
+  static void shrinkIfWasteful(GateEvolution_t& levels);
+  
+  /// Returns the fingerprint of the current gate content (no caching).
+  std::uint64_t computeFingerprint() const;
   
   
   /// Helper returning the starting state of the levels at construction time.
@@ -503,6 +759,9 @@ class icarus::trigger::TriggerGateData {
 
 #include "sbnobj/ICARUS/PMT/Trigger/Data/TriggerGateData.tcc"
 
+// the view needs the full definition of this class, and implements `view()`
+#include "sbnobj/ICARUS/PMT/Trigger/Data/TriggerGateView.h"
+
 //------------------------------------------------------------------------------
 
 
@@ -9,6 +9,9 @@
 #ifndef SBNOBJ_ICARUS_PMT_TRIGGER_DATA_TRIGGERGATEDATA_TCC
 #define SBNOBJ_ICARUS_PMT_TRIGGER_DATA_TRIGGERGATEDATA_TCC
 
+// SBN libraries
+#include "sbnobj/Common/Utilities/HashMixing.h" // sbn::details::mixHash()
+
 // LArSoft libraries
 #include "larcorealg/CoreUtils/StdUtils.h" // util::to_string()
 
@@ -78,7 +81,8 @@ auto icarus::trigger::TriggerGateData<TK, TI>::findMaxOpen
 
 //------------------------------------------------------------------------------
 template <typename TK, typename TI>
-void icarus::trigger::TriggerGateData<TK, TI>::compact() {
+template <typename Instr>
+void icarus::trigger::TriggerGateData<TK, TI>::removeRedundantStatuses() {
   
   /*
    * Removes:
@@ -90,36 +94,118 @@ void icarus::trigger::TriggerGateData<TK, TI>::compact() {
    * 
    */
   
+  typename Instr::template Recorder<GateEvolution_t> record
+    { instrumentation::Operation::Compact, fGateLevel };
+  
   auto const send = fGateLevel.end();
   auto iLast = fGateLevel.begin(); // last good status
   auto iDest = std::next(iLast); // the status next to be assigned
   auto iTest = iDest; // the next status candidate
   
-  // declare the current candidate status good:
-  auto accept = [&iDest, &iTest, &iLast]()
-    { if (iDest != iTest) *iDest = *iTest; iLast = iDest; ++iDest; };
-  
   while (iTest != send) {
     
-    switch (iTest->event) {
-      case EventType::Shift:
-        if (iLast->opening != iTest->opening) accept();
-        break;
-      case EventType::Set:
-        if (iTest->tick > iLast->tick) accept();
-        break;
-      case EventType::Unknown:
-        accept();
-        break;
-    } // switch
+    // keep the candidate status unless it is redundant:
+    if (!isRedundantStatus(*iLast, *iTest)) {
+      if (iDest != iTest) *iDest = *iTest;
+      iLast = iDest;
+      ++iDest;
+    }
     
     ++iTest;
     
   } // while
   
-  fGateLevel.erase(iDest, send);
+  record.scanned(fGateLevel.size());
+  if (iDest != send) {
+    record.erased(send - iDest);
+    fGateLevel.erase(iDest, send);
+    // the fingerprint already ignores redundant statuses: no change there
+  }
   
-} // icarus::trigger::TriggerGateData<>::compact()
+  fMayNeedCompaction = false;
+  
+} // icarus::trigger::TriggerGateData<>::removeRedundantStatuses()
+
+
+//------------------------------------------------------------------------------
+template <typename ClockTick, typename OpeningCount>
+bool icarus::trigger::details::isRedundantGateStatus(
+  TriggerGateStatus<ClockTick, OpeningCount> const& lastKept,
+  TriggerGateStatus<ClockTick, OpeningCount> const& status
+) {
+  switch (status.event) {
+    case TriggerGateEventType::Shift: // shifts that don't change opening level
+      return lastKept.opening == status.opening;
+    case TriggerGateEventType::Set: // multiple sets at the same tick
+      return status.tick <= lastKept.tick;
+    case TriggerGateEventType::Unknown: // they might have reason to be
+      break;
+  } // switch
+  return false;
+} // icarus::trigger::details::isRedundantGateStatus()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI>
+bool icarus::trigger::TriggerGateData<TK, TI>::isRedundantStatus
+  (Status const& lastKept, Status const& status)
+  { return details::isRedundantGateStatus(lastKept, status); }
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI>
+void icarus::trigger::TriggerGateData<TK, TI>::shrinkIfWasteful
+  (GateEvolution_t& levels)
+{
+  // reallocation is not worth for less than a quarter of the memory
+  std::size_t const waste = levels.capacity() - levels.size();
+  if (waste > std::max(MinShrinkWaste, levels.size() / 4U))
+    levels.shrink_to_fit();
+} // icarus::trigger::TriggerGateData<>::shrinkIfWasteful()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI>
+auto icarus::trigger::TriggerGateData<TK, TI>::fingerprint() const
+  -> std::uint64_t
+{
+  if (!fFingerprint.valid()) fFingerprint.store(computeFingerprint());
+  return fFingerprint.load();
+} // icarus::trigger::TriggerGateData<>::fingerprint()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI>
+auto icarus::trigger::TriggerGateData<TK, TI>::computeFingerprint() const
+  -> std::uint64_t
+{
+  /*
+   * Hash of the statuses surviving compaction, each folded in the hash with
+   * `sbn::details::mixHash()`; the hash value reserved to mark the absence of
+   * a fingerprint is remapped.
+   */
+  auto const mixStatus = [](std::uint64_t hash, Status const& status)
+    {
+      using sbn::details::mixHash;
+      hash = mixHash(hash, static_cast<std::uint64_t>(status.event));
+      hash = mixHash(hash, static_cast<std::uint64_t>(status.tick));
+      return mixHash(hash, static_cast<std::uint64_t>(status.opening));
+    };
+  
+  assert(!fGateLevel.empty());
+  
+  auto const send = fGateLevel.end();
+  auto iLast = fGateLevel.begin();
+  std::uint64_t hash = mixStatus(0U, *iLast);
+  for (auto iStatus = std::next(iLast); iStatus != send; ++iStatus) {
+    if (isRedundantStatus(*iLast, *iStatus)) continue;
+    hash = mixStatus(hash, *iStatus);
+    iLast = iStatus;
+  } // for
+  
+  return (hash == details::TriggerGateFingerprintCache::NoFingerprint)
+    ? ~hash: hash;
+} // icarus::trigger::TriggerGateData<>::computeFingerprint()
 
 
 //------------------------------------------------------------------------------
@@ -174,13 +260,39 @@ auto icarus::trigger::TriggerGateData<TK, TI>::openingCount
 
 //------------------------------------------------------------------------------
 template <typename TK, typename TI>
+template <typename Instr>
 void icarus::trigger::TriggerGateData<TK, TI>::setOpeningAt
   (ClockTick_t tick, OpeningCount_t openingCount)
 {
-  //
   // first find where to start acting
-  //
-  auto iStatus = findLastStatusForTickOrThrow(tick); // may be before the tick
+  setOpeningFrom<Instr>
+    (findLastStatusForTickOrThrow(tick), tick, openingCount);
+} // icarus::trigger::TriggerGateData<>::setOpeningAt()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI>
+template <typename Instr>
+auto icarus::trigger::TriggerGateData<TK, TI>::setOpeningAtUnchecked
+  (ClockTick_t tick, OpeningCount_t openingCount) -> MutationStatus
+{
+  auto const iStatus = findLastStatusFor(tick); // may be before the tick
+  if (!iStatus) return MutationStatus::TickBeforeGate;
+  setOpeningFrom<Instr>(iStatus.value(), tick, openingCount);
+  return MutationStatus::Success;
+} // icarus::trigger::TriggerGateData<>::setOpeningAtUnchecked()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI>
+template <typename Instr>
+void icarus::trigger::TriggerGateData<TK, TI>::setOpeningFrom
+  (status_iterator iStatus, ClockTick_t tick, OpeningCount_t openingCount)
+{
+  typename Instr::template Recorder<GateEvolution_t> record
+    { instrumentation::Operation::SetOpeningAt, fGateLevel };
+  
+  contentChanged();
   
   //
   // set the current status (possibly a new one)
@@ -193,6 +305,7 @@ void icarus::trigger::TriggerGateData<TK, TI>::setOpeningAt
     // insert the new status after iStatus
     iStatus = fGateLevel.insert
       (++iStatus, { EventType::Set, tick, openingCount });
+    record.inserted();
   }
   
   //
@@ -201,9 +314,11 @@ void icarus::trigger::TriggerGateData<TK, TI>::setOpeningAt
   //
   ++iStatus; // start from the status next to the one we just changed/added
   while (iStatus != fGateLevel.end()) {
+    record.scanned();
     switch (iStatus->event) {
       case EventType::Shift: // just remove the shift event
         iStatus = fGateLevel.erase(iStatus);
+        record.erased();
         break;
       case EventType::Set: // the later Set event takes over, we are done
         return;
@@ -213,11 +328,12 @@ void icarus::trigger::TriggerGateData<TK, TI>::setOpeningAt
     } // switch event type
   }
   
-} // icarus::trigger::TriggerGateData<>::setOpeningAt()
+} // icarus::trigger::TriggerGateData<>::setOpeningFrom()
 
 
 //------------------------------------------------------------------------------
 template <typename TK, typename TI>
+template <typename Instr>
 void icarus::trigger::TriggerGateData<TK, TI>::openBetween
   (ClockTick_t start, ClockTick_t end, OpeningDiff_t count /* = 1 */)
 {
@@ -235,7 +351,53 @@ void icarus::trigger::TriggerGateData<TK, TI>::openBetween
   //
   // (1) first find where to start acting
   //
-  auto iStatus = findLastStatusForTickOrThrow(start); // may be before the start
+  auto const iStatus
+    = findLastStatusForTickOrThrow(start); // may be before the start
+  
+  Status failed;
+  if (openBetweenFrom<true, Instr>(iStatus, start, end, count, &failed)
+    != MutationStatus::Success)
+  {
+    throwOpeningUnderflow(start, count, failed);
+  }
+  
+} // icarus::trigger::TriggerGateData<>::openBetween()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI>
+template <typename Instr>
+auto icarus::trigger::TriggerGateData<TK, TI>::openBetweenUnchecked
+  (ClockTick_t start, ClockTick_t end, OpeningDiff_t count /* = 1 */)
+  -> MutationStatus
+{
+  if (start >= end) return MutationStatus::Success; // weird, yet valid
+  
+  auto const iStatus = findLastStatusFor(start); // may be before the start
+  if (!iStatus) return MutationStatus::TickBeforeGate;
+  
+  return openBetweenFrom<CheckUncheckedPreconditions, Instr>
+    (iStatus.value(), start, end, count);
+    
+} // icarus::trigger::TriggerGateData<>::openBetweenUnchecked()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI>
+template <bool CheckUnderflow, typename Instr>
+auto icarus::trigger::TriggerGateData<TK, TI>::openBetweenFrom(
+  status_iterator iStatus, ClockTick_t start, ClockTick_t end,
+  OpeningDiff_t count, Status* failed /* = nullptr */
+) -> MutationStatus
+{
+  // see `openBetween()` for the plan; (1) has already been performed
+  assert(start < end);
+  assert(iStatus->tick <= start);
+  
+  typename Instr::template Recorder<GateEvolution_t> record
+    { instrumentation::Operation::OpenBetween, fGateLevel };
+  
+  contentChanged();
   
   //
   // (2) set the current status (possibly a new one)
@@ -256,12 +418,14 @@ void icarus::trigger::TriggerGateData<TK, TI>::openBetween
     auto const opening = iStatus->opening + count;
     iStatus = fGateLevel.insert
       (++iStatus, { EventType::Shift, start, opening });
+    record.inserted();
   }
   
   //
   // (3) also find where to stop acting
   //
-  auto send = findLastStatusForTickOrThrow(end); // may be before `end`
+  // `end` is after `start`, so it can't be before the start of the gate
+  auto send = findLastStatusFor(end).value(); // may be before `end`
   // if `send` is stricly earlier than `end`, we want it affected too
   if (send->tick < end) ++send;
   
@@ -270,22 +434,19 @@ void icarus::trigger::TriggerGateData<TK, TI>::openBetween
   // the "Shift" action stops when a set happens, and stacks with other shifts
   //
   while (++iStatus != send) {
+    record.scanned();
     switch (iStatus->event) {
       case EventType::Shift: // change the resulting opening
-        if ((count < 0) && (iStatus->opening < OpeningCount_t(-count))) {
-          throw std::runtime_error(
-            "icarus::trigger::TriggerGateData::openBetween(): "
-            "asked to close " + util::to_string(-count)
-            + " gate counts starting at "
-            + util::to_string(start) + " but at time "
-            + util::to_string(iStatus->tick) + " only "
-            + util::to_string(iStatus->opening) + " are still open"
-            );
+        if constexpr (CheckUnderflow) {
+          if ((count < 0) && (iStatus->opening < OpeningCount_t(-count))) {
+            if (failed) *failed = *iStatus;
+            return MutationStatus::OpeningUnderflow;
+          }
         }
         iStatus->opening += count;
         break;
       case EventType::Set: // (4.1) Set event takes over, we are done
-        return;
+        return MutationStatus::Success;
       case EventType::Unknown: // not sure about this... let's keep going
         break;
     } // switch event type
@@ -310,23 +471,79 @@ void icarus::trigger::TriggerGateData<TK, TI>::openBetween
   else { // no status exactly at this tick, just need to insert one
     // insert the new status before iStatus;
     // the correct opening now is the last one, minus what we added;
-    // it is also the status in iStatus, if it exists
+    // the status in iStatus, if it exists, is not a good reference since it
+    // may be after further changes not affected by this opening
     assert(iStatus != fGateLevel.begin()); // we must have added one status!
     
-    auto const opening = (iStatus == fGateLevel.end())
-      ? (std::prev(iStatus)->opening - count): (iStatus->opening);
-    
-    // checking that if the two branches above are both available, they match;
-    // the branch above just takes the easier way when available
-    assert((iStatus == fGateLevel.end())
-      || (opening == (std::prev(iStatus)->opening - count))
-      );
+    auto const opening = std::prev(iStatus)->opening - count;
     
     iStatus = fGateLevel.insert(iStatus, { EventType::Shift, end, opening });
+    record.inserted();
   }
   // if we get here, now iStatus contains the gate closing (for what we care)
   
-} // icarus::trigger::TriggerGateData<>::openFor()
+  return MutationStatus::Success;
+} // icarus::trigger::TriggerGateData<>::openBetweenFrom()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI>
+template <typename Instr, typename Intervals>
+void icarus::trigger::TriggerGateData<TK, TI>::openInIntervals
+  (Intervals const& intervals, OpeningDiff_t count /* = 1 */)
+{
+  /*
+   * Each interval starting at or after the last status of the gate can't affect
+   * any existing status but the last one, so its opening and closing statuses
+   * are appended straight away; any other interval takes the general route.
+   */
+  typename Instr::template Recorder<GateEvolution_t> record
+    { instrumentation::Operation::OpenInIntervals, fGateLevel };
+  
+  fGateLevel.reserve(fGateLevel.size() + 2 * std::size(intervals));
+  contentChanged();
+  
+  for (auto const& [ start, end ]: intervals) {
+    
+    if (start >= end) continue; // weird, yet valid
+    
+    Status& lastStatus = fGateLevel.back();
+    if ((start < lastStatus.tick)
+      || ((count < 0) && (lastStatus.opening < OpeningCount_t(-count)))
+    ) {
+      // let the general algorithm deal with it
+      openBetween<Instr>(start, end, count);
+      continue;
+    }
+    
+    OpeningCount_t const closedOpening = lastStatus.opening;
+    if (lastStatus.tick == start) { // there is already something here
+      if (lastStatus.event == EventType::Unknown)
+        lastStatus.event = EventType::Shift;
+      lastStatus.opening += count;
+    }
+    else {
+      fGateLevel.emplace_back(EventType::Shift, start, closedOpening + count);
+      record.inserted();
+    }
+    
+    fGateLevel.emplace_back(EventType::Shift, end, closedOpening);
+    record.inserted();
+    
+  } // for intervals
+  
+} // icarus::trigger::TriggerGateData<>::openInIntervals()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI>
+void icarus::trigger::TriggerGateData<TK, TI>::takeGateLevels
+  (triggergatedata_t&& other)
+{
+  fGateLevel = std::move(other.fGateLevel);
+  contentChanged();
+  fMayNeedCompaction = other.fMayNeedCompaction;
+} // icarus::trigger::TriggerGateData<>::takeGateLevels()
 
 
 //------------------------------------------------------------------------------
@@ -334,7 +551,7 @@ template <typename TK, typename TI>
 auto icarus::trigger::TriggerGateData<TK, TI>::Min
   (TriggerGateData const& other) -> triggergatedata_t&
 {
-  fGateLevel = std::move(TriggerGateData::Min(*this, other).fGateLevel);
+  takeGateLevels(TriggerGateData::Min(*this, other));
   return *this;
 } // icarus::trigger::TriggerGateData<>::Min()
 
@@ -344,7 +561,7 @@ template <typename TK, typename TI>
 auto icarus::trigger::TriggerGateData<TK, TI>::Max
   (TriggerGateData const& other) -> triggergatedata_t&
 {
-  fGateLevel = std::move(TriggerGateData::Max(*this, other).fGateLevel);
+  takeGateLevels(TriggerGateData::Max(*this, other));
   return *this;
 } // icarus::trigger::TriggerGateData<>::Max()
 
@@ -354,7 +571,7 @@ template <typename TK, typename TI>
 auto icarus::trigger::TriggerGateData<TK, TI>::Sum
   (TriggerGateData const& other) -> triggergatedata_t&
 {
-  fGateLevel = std::move(TriggerGateData::Sum(*this, other).fGateLevel);
+  takeGateLevels(TriggerGateData::Sum(*this, other));
   return *this;
 } // icarus::trigger::TriggerGateData<>::Sum()
 
@@ -364,7 +581,7 @@ template <typename TK, typename TI>
 auto icarus::trigger::TriggerGateData<TK, TI>::Mul
   (TriggerGateData const& other) -> triggergatedata_t&
 {
-  fGateLevel = std::move(TriggerGateData::Mul(*this, other).fGateLevel);
+  takeGateLevels(TriggerGateData::Mul(*this, other));
   return *this;
 } // icarus::trigger::TriggerGateData<>::Mul()
 
@@ -409,7 +626,7 @@ auto icarus::trigger::TriggerGateData<TK, TI>::Mul
 
 //------------------------------------------------------------------------------
 template <typename TK, typename TI>
-template <typename Op>
+template <typename Instr, typename Op>
 auto icarus::trigger::TriggerGateData<TK, TI>::SymmetricCombination(
   Op&& op, triggergatedata_t const& a, triggergatedata_t const& b,
   ClockTicks_t aDelay /* = { 0 } */, ClockTicks_t bDelay /* { = 0 } */
@@ -537,6 +754,8 @@ auto icarus::trigger::TriggerGateData<TK, TI>::SymmetricCombination(
   // prepare the container of the combination:
   triggergatedata_t result;
   auto& resultLevels = result.fGateLevel;
+  typename Instr::template Recorder<GateEvolution_t> record
+    { instrumentation::Operation::SymmetricCombination, resultLevels };
   resultLevels.reserve(a.fGateLevel.size() + b.fGateLevel.size() - 1U);
   
   // the state automatically selects the earliest as start
@@ -552,8 +771,20 @@ auto icarus::trigger::TriggerGateData<TK, TI>::SymmetricCombination(
   // the late gate; we choose that value to be the same as the other gate.
   state.other().prevLevel = startOpening;
   
+  // whether any status may be removed by `compact()`: each status is checked
+  // against the previous one every time it is changed, and when a status is
+  // found redundant the compaction of the result is needed
+  bool redundant = false;
+  auto const isLastRedundant = [&resultLevels]()
+    {
+      auto const iLast = std::prev(resultLevels.end());
+      return (iLast != resultLevels.begin())
+        && isRedundantStatus(*std::prev(iLast), *iLast);
+    };
+  
   while (state.next()) {
     
+    record.scanned();
     auto const& newStatus = state.current();
     
     // quick way out: if the event does not change its gate level, it's out
@@ -571,12 +802,16 @@ auto icarus::trigger::TriggerGateData<TK, TI>::SymmetricCombination(
     }
     else { // add a new status
       resultLevels.emplace_back(EventType::Shift, newTick, newLevel);
+      record.inserted();
     }
+    if (!redundant) redundant = isLastRedundant();
     
   } // while
   
-  result.compact();
-  resultLevels.shrink_to_fit();
+  result.fMayNeedCompaction = redundant;
+  result.template compact<Instr>();
+  shrinkIfWasteful(resultLevels);
+  record.finish(); // before `result` is possibly moved away
   
   return result;
 } // icarus::trigger::TriggerGateData<>::SymmetricCombination()
@@ -587,6 +822,12 @@ template <typename TK, typename TI>
 bool icarus::trigger::TriggerGateData<TK, TI>::operator ==
   (TriggerGateData const& other) const
 {
+  if (hasFingerprint() && other.hasFingerprint()
+    && (fingerprint() != other.fingerprint())
+    )
+  {
+    return false;
+  }
   return fGateLevel == other.fGateLevel;
 } // bool icarus::trigger::TriggerGateData<>::operator==
 
@@ -596,10 +837,43 @@ template <typename TK, typename TI>
 bool icarus::trigger::TriggerGateData<TK, TI>::operator !=
   (TriggerGateData const& other) const
 {
-  return fGateLevel != other.fGateLevel;
+  return !(*this == other);
 } // bool icarus::trigger::TriggerGateData<>::operator==
 
 
+//------------------------------------------------------------------------------
+template <typename TK, typename TI>
+bool icarus::trigger::TriggerGateData<TK, TI>::sameLevels
+  (TriggerGateData const& other) const
+{
+  if (fingerprint() != other.fingerprint()) return false;
+  
+  // the two status lists are walked together, skipping redundant statuses
+  auto const nextKept = [](auto iLast, auto iStatus, auto const send)
+    {
+      while ((iStatus != send) && isRedundantStatus(*iLast, *iStatus))
+        ++iStatus;
+      return iStatus;
+    };
+  
+  assert(!fGateLevel.empty());
+  assert(!other.fGateLevel.empty());
+  auto const send = fGateLevel.end(), oend = other.fGateLevel.end();
+  auto iLast = fGateLevel.begin(), iOLast = other.fGateLevel.begin();
+  if (*iLast != *iOLast) return false;
+  while (true) {
+    auto const iStatus = nextKept(iLast, std::next(iLast), send);
+    auto const iOStatus = nextKept(iOLast, std::next(iOLast), oend);
+    if ((iStatus == send) || (iOStatus == oend))
+      return (iStatus == send) && (iOStatus == oend);
+    if (*iStatus != *iOStatus) return false;
+    iLast = iStatus;
+    iOLast = iOStatus;
+  } // while
+  
+} // bool icarus::trigger::TriggerGateData<>::sameLevels()
+
+
 //------------------------------------------------------------------------------
 template <typename TK, typename TI>
 auto icarus::trigger::TriggerGateData<TK, TI>::findLastStatusFor
@@ -638,12 +912,7 @@ auto icarus::trigger::TriggerGateData<TK, TI>::findLastStatusForTickOrThrow
   auto const iStatus = findLastStatusFor(tick); // status may be before the tick
   if (iStatus) return iStatus.value();
   // this should be not even possible
-  throw std::runtime_error(
-    "icarus::trigger::TriggerGateData: requested time " + util::to_string(tick)
-    + " is before the gate channel was created (at "
-    + util::to_string(fGateLevel.front().tick)
-    + ")"
-    );
+  throwTickBeforeGate(tick);
 } // icarus::trigger::TriggerGateData<>::findLastStatusForTickOrThrow()
 
 
@@ -655,13 +924,38 @@ auto icarus::trigger::TriggerGateData<TK, TI>::findLastStatusForTickOrThrow
   auto const iStatus = findLastStatusFor(tick); // status may be before the tick
   if (iStatus) return iStatus.value();
   // this should be not even possible
+  throwTickBeforeGate(tick);
+} // icarus::trigger::TriggerGateData<>::findLastStatusForTickOrThrow() const
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI>
+void icarus::trigger::TriggerGateData<TK, TI>::throwTickBeforeGate
+  (ClockTick_t tick) const
+{
   throw std::runtime_error(
     "icarus::trigger::TriggerGateData: requested time " + util::to_string(tick)
     + " is before the gate channel was created (at "
     + util::to_string(fGateLevel.front().tick)
     + ")"
     );
-} // icarus::trigger::TriggerGateData<>::findLastStatusForTickOrThrow() const
+} // icarus::trigger::TriggerGateData<>::throwTickBeforeGate()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI>
+void icarus::trigger::TriggerGateData<TK, TI>::throwOpeningUnderflow
+  (ClockTick_t start, OpeningDiff_t count, Status const& status)
+{
+  throw std::runtime_error(
+    "icarus::trigger::TriggerGateData::openBetween(): "
+    "asked to close " + util::to_string(-count)
+    + " gate counts starting at "
+    + util::to_string(start) + " but at time "
+    + util::to_string(status.tick) + " only "
+    + util::to_string(status.opening) + " are still open"
+    );
+} // icarus::trigger::TriggerGateData<>::throwOpeningUnderflow()
 
 
 //------------------------------------------------------------------------------
@@ -687,9 +981,17 @@ auto icarus::trigger::TriggerGateData<TK, TI>::findStatus
     : fGateLevel.begin()
     ;
   
+  // statuses which `compact()` would remove are skipped, so that the result
+  // does not depend on whether the gate was compacted or not
   auto const send = fGateLevel.end();
+  auto iLastKept
+    = (iStatus == fGateLevel.begin())? send: std::prev(iStatus);
   while (iStatus != send) {
     if (iStatus->tick >= end) break;
+    if ((iLastKept != send) && isRedundantStatus(*iLastKept, *iStatus)) {
+      ++iStatus;
+      continue;
+    }
     switch (iStatus->event) {
       case EventType::Shift:
       case EventType::Set:
@@ -698,11 +1000,11 @@ auto icarus::trigger::TriggerGateData<TK, TI>::findStatus
       case EventType::Unknown:
         break;
     } // switch
-    ++iStatus;
+    iLastKept = iStatus++;
   } // while
   return send;
   
-} // icarus::trigger::TriggerGateData<>::findOpenStatus()
+} // icarus::trigger::TriggerGateData<>::findStatus()
 
 
 //------------------------------------------------------------------------------
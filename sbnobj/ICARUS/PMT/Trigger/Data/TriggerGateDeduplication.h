@@ -0,0 +1,135 @@
+/**
+ * @file   sbnobj/ICARUS/PMT/Trigger/Data/TriggerGateDeduplication.h
+ * @brief  Utilities to find duplicate gates in a collection.
+ * 
+ * This is a header-only library.
+ */
+
+#ifndef SBNOBJ_ICARUS_PMT_TRIGGER_DATA_TRIGGERGATEDEDUPLICATION_H
+#define SBNOBJ_ICARUS_PMT_TRIGGER_DATA_TRIGGERGATEDEDUPLICATION_H
+
+
+// C/C++ standard libraries
+#include <vector>
+#include <algorithm> // std::sort()
+#include <iterator> // std::begin(), std::size()
+#include <utility> // std::pair, std::move()
+#include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+namespace icarus::trigger {
+  
+  /**
+   * @brief Returns the index of the first occurrence of each distinct gate.
+   * @tparam Gates type of collection of gates
+   * @param gates the collection of gates
+   * @return the sorted list of indices of the unique gates in `gates`
+   * @see `removeDuplicateGates()`
+   * 
+   * Two gates are considered duplicate if they have the same channels and the
+   * same gate levels after compaction (`TriggerGateData::sameLevels()`), that
+   * is ignoring the redundant statuses as `TriggerGateData::fingerprint()`
+   * does. The gates are first grouped by their fingerprint, and only gates
+   * within the same group are compared, which makes the complexity
+   * _O(N log N)_ in the number of gates rather than quadratic.
+   * 
+   * The gates in `gates` need to expose the gate level data via `gateLevels()`
+   * and their channels via `channels()`, as all the gate classes derived from
+   * `ReadoutTriggerGate` do.
+   */
+  template <typename Gates>
+  std::vector<std::size_t> findUniqueGates(Gates const& gates);
+  
+  
+  /**
+   * @brief Removes from `gates` all the gates equal to a previous one.
+   * @tparam Gate type of the gate in the collection
+   * @param gates the collection of gates to be made unique
+   * @return the number of removed gates
+   * @see `findUniqueGates()`
+   * 
+   * The relative order of the surviving gates is preserved.
+   */
+  template <typename Gate>
+  std::size_t removeDuplicateGates(std::vector<Gate>& gates);
+  
+} // namespace icarus::trigger
+
+
+//------------------------------------------------------------------------------
+//--- template implementation
+//------------------------------------------------------------------------------
+template <typename Gates>
+std::vector<std::size_t> icarus::trigger::findUniqueGates(Gates const& gates) {
+  
+  auto const gbegin = std::begin(gates);
+  std::size_t const nGates = std::size(gates);
+  
+  // sort the gate indices by fingerprint (and index, to preserve the order)
+  std::vector<std::pair<std::uint64_t, std::size_t>> fingerprints;
+  fingerprints.reserve(nGates);
+  auto iGate = gbegin;
+  for (std::size_t index = 0U; index < nGates; ++index, ++iGate)
+    fingerprints.emplace_back(iGate->gateLevels().fingerprint(), index);
+  std::sort(fingerprints.begin(), fingerprints.end());
+  
+  std::vector<std::size_t> unique;
+  auto const fend = fingerprints.cend();
+  auto iGroup = fingerprints.cbegin();
+  while (iGroup != fend) {
+  
+    // the group of gates with the same fingerprint
+    auto iGroupEnd = std::next(iGroup);
+    while ((iGroupEnd != fend) && (iGroupEnd->first == iGroup->first))
+      ++iGroupEnd;
+    
+    // within the group, each gate is compared to all the unique ones so far
+    std::size_t const firstUnique = unique.size();
+    for (auto iCand = iGroup; iCand != iGroupEnd; ++iCand) {
+      auto const& candidate = *std::next(gbegin, iCand->second);
+      bool isDuplicate = false;
+      for (std::size_t iUnique = firstUnique; iUnique < unique.size(); ++iUnique)
+      {
+        auto const& uniqueGate = *std::next(gbegin, unique[iUnique]);
+        if (uniqueGate.channels() != candidate.channels()) continue;
+        if (!uniqueGate.gateLevels().sameLevels(candidate.gateLevels()))
+          continue;
+        isDuplicate = true;
+        break;
+      } // for unique gates
+      if (!isDuplicate) unique.push_back(iCand->second);
+    } // for candidates in group
+    
+    iGroup = iGroupEnd;
+  } // while
+  
+  std::sort(unique.begin(), unique.end());
+  return unique;
+} // icarus::trigger::findUniqueGates()
+
+
+//------------------------------------------------------------------------------
+template <typename Gate>
+std::size_t icarus::trigger::removeDuplicateGates(std::vector<Gate>& gates) {
+  
+  std::vector<std::size_t> const unique = findUniqueGates(gates);
+  std::size_t const nDuplicates = gates.size() - unique.size();
+  if (nDuplicates == 0U) return 0U;
+  
+  // unique indices are sorted and never behind their destination
+  std::size_t iDest = 0U;
+  for (std::size_t const index: unique) {
+    if (index != iDest) gates[iDest] = std::move(gates[index]);
+    ++iDest;
+  } // for
+  gates.erase(gates.begin() + iDest, gates.end());
+  
+  return nDuplicates;
+} // icarus::trigger::removeDuplicateGates()
+
+
+//------------------------------------------------------------------------------
+
+#endif // SBNOBJ_ICARUS_PMT_TRIGGER_DATA_TRIGGERGATEDEDUPLICATION_H
@@ -0,0 +1,268 @@
+/**
+ * @file   sbnobj/ICARUS/PMT/Trigger/Data/TriggerGateInstrumentation.h
+ * @brief  Optional counters of the operations on trigger gates.
+ * 
+ * This is a header-only library.
+ * 
+ * The instrumentation is selected at compile time, call by call, via the
+ * policy template argument of the instrumented operations of
+ * `icarus::trigger::TriggerGateData`: the default policy,
+ * `icarus::trigger::instrumentation::NoRecording`, does nothing and costs
+ * nothing.
+ */
+
+#ifndef SBNOBJ_ICARUS_PMT_TRIGGER_DATA_TRIGGERGATEINSTRUMENTATION_H
+#define SBNOBJ_ICARUS_PMT_TRIGGER_DATA_TRIGGERGATEINSTRUMENTATION_H
+
+
+// C/C++ standard libraries
+#include <ostream>
+#include <iomanip> // std::setw()
+#include <array>
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+/**
+ * @brief Counters of the operations on `icarus::trigger::TriggerGateData`.
+ * 
+ * The operations modifying the gates which are called with the `Recording`
+ * policy record in counters how many times they are called, how many statuses
+ * they insert, erase and scan, and how many times they cause the status list
+ * to be reallocated. The operations called with the default `NoRecording`
+ * policy are compiled without any recording code.
+ * The policy is a template argument, so that the instrumented and the plain
+ * versions of an operation are different functions and code with and without
+ * instrumentation can be linked together.
+ * The counters are kept per thread, so that no synchronization is needed; the
+ * counters of different threads can be summed together.
+ * 
+ * Example of usage:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * namespace instr = icarus::trigger::instrumentation;
+ * instr::threadCounters().reset();
+ * gate.openBetween<instr::Recording>(start, end);
+ * auto const combined
+ *   = Gate_t::SymmetricCombination<instr::Recording>(op, gate, other);
+ * instr::report(std::cout, instr::threadCounters());
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * Within a single call, all the operations it performs use its policy: for
+ * example `SymmetricCombination<Recording>()` also records its `compact()`.
+ */
+namespace icarus::trigger::instrumentation {
+  
+  /// Instrumented operations.
+  enum class Operation: unsigned int {
+    OpenBetween,          ///< `TriggerGateData::openBetween()`
+    OpenInIntervals,      ///< `TriggerGateData::openInIntervals()`
+    SetOpeningAt,         ///< `TriggerGateData::setOpeningAt()`
+    Compact,              ///< `TriggerGateData::compact()`
+    SymmetricCombination, ///< `TriggerGateData::SymmetricCombination()`
+    NOperations           ///< Number of instrumented operations.
+  }; // Operation
+  
+  /// Number of instrumented operations.
+  inline constexpr std::size_t NOperations
+    = static_cast<std::size_t>(Operation::NOperations);
+  
+  /// Returns the name of the specified operation.
+  constexpr const char* name(Operation op);
+  
+  
+  /// Counters for a single operation.
+  struct OperationCounters {
+  
+    std::size_t calls = 0U; ///< Number of calls.
+    std::size_t inserted = 0U; ///< Number of statuses inserted.
+    std::size_t erased = 0U; ///< Number of statuses erased.
+    std::size_t reallocations = 0U; ///< Times the status list was reallocated.
+    std::size_t scanned = 0U; ///< Number of statuses looked at.
+    
+    /// Adds the counts from `other` to these.
+    OperationCounters& operator+= (OperationCounters const& other);
+  
+  }; // OperationCounters
+  
+  
+  /// Counters for all the instrumented operations.
+  struct Counters {
+  
+    /// Counters for each operation.
+    std::array<OperationCounters, NOperations> operations;
+    
+    /// Returns the counters of the specified operation.
+    OperationCounters& operator[] (Operation op)
+      { return operations[static_cast<std::size_t>(op)]; }
+    
+    /// Returns the counters of the specified operation.
+    OperationCounters const& operator[] (Operation op) const
+      { return operations[static_cast<std::size_t>(op)]; }
+    
+    /// Adds the counts from `other` (e.g. from another thread) to these.
+    Counters& operator+= (Counters const& other);
+    
+    /// Sets all the counts to `0`.
+    void reset() { operations = {}; }
+  
+  }; // Counters
+  
+  
+  /// Returns the counters of the current thread.
+  Counters& threadCounters();
+  
+  /// Prints a table with the content of the `counters` into `out`.
+  void report(std::ostream& out, Counters const& counters);
+  
+  
+  // ---------------------------------------------------------------------------
+  /**
+   * @brief Records the counts of a single call to an operation.
+   * @tparam Container type of the container of the gate statuses
+   * 
+   * The object counts a call at construction, and checks whether the container
+   * was reallocated at destruction, or at an explicit call to `finish()` if the
+   * container is going to be moved away before that. Other counts are recorded
+   * explicitly.
+   */
+  template <typename Container>
+  class OperationRecorder {
+  
+    OperationCounters& fCounters; ///< Where to record the counts.
+    Container const* fContainer; ///< The container being monitored.
+    std::size_t const fCapacity; ///< Capacity of the container at start.
+    
+      public:
+    
+    OperationRecorder(Operation op, Container const& container)
+      : fCounters(threadCounters()[op])
+      , fContainer(&container)
+      , fCapacity(container.capacity())
+      { ++fCounters.calls; }
+    
+    OperationRecorder(OperationRecorder const&) = delete;
+    OperationRecorder& operator= (OperationRecorder const&) = delete;
+    
+    ~OperationRecorder() { finish(); }
+    
+    /// Records the insertion of `n` statuses.
+    void inserted(std::size_t n = 1U) { fCounters.inserted += n; }
+    
+    /// Records the erasure of `n` statuses.
+    void erased(std::size_t n = 1U) { fCounters.erased += n; }
+    
+    /// Records that `n` statuses were looked at.
+    void scanned(std::size_t n = 1U) { fCounters.scanned += n; }
+    
+    /// Checks for reallocation and stops monitoring the container.
+    void finish()
+      {
+        if (!fContainer) return;
+        if (fContainer->capacity() != fCapacity) ++fCounters.reallocations;
+        fContainer = nullptr;
+      }
+  
+  }; // OperationRecorder<>
+  
+  
+  /// Recorder with the interface of `OperationRecorder` which does nothing.
+  template <typename Container>
+  class NullRecorder {
+      public:
+    NullRecorder(Operation, Container const&) {}
+    void inserted(std::size_t = 1U) {}
+    void erased(std::size_t = 1U) {}
+    void scanned(std::size_t = 1U) {}
+    void finish() {}
+  }; // NullRecorder<>
+  
+  
+  // ---------------------------------------------------------------------------
+  /// Instrumentation policy: the operations are not recorded (default).
+  struct NoRecording {
+    template <typename Container>
+    using Recorder = NullRecorder<Container>;
+  }; // NoRecording
+  
+  /// Instrumentation policy: the operations are recorded in `threadCounters()`.
+  struct Recording {
+    template <typename Container>
+    using Recorder = OperationRecorder<Container>;
+  }; // Recording
+
+
+} // namespace icarus::trigger::instrumentation
+
+
+//------------------------------------------------------------------------------
+//---  Inline implementation
+//------------------------------------------------------------------------------
+constexpr const char* icarus::trigger::instrumentation::name(Operation op) {
+  switch (op) {
+    case Operation::OpenBetween:          return "openBetween";
+    case Operation::OpenInIntervals:      return "openInIntervals";
+    case Operation::SetOpeningAt:         return "setOpeningAt";
+    case Operation::Compact:              return "compact";
+    case Operation::SymmetricCombination: return "SymmetricCombination";
+    case Operation::NOperations:          break;
+  } // switch
+  return "<unknown>";
+} // icarus::trigger::instrumentation::name()
+
+
+//------------------------------------------------------------------------------
+inline auto icarus::trigger::instrumentation::OperationCounters::operator+=
+  (OperationCounters const& other) -> OperationCounters&
+{
+  calls += other.calls;
+  inserted += other.inserted;
+  erased += other.erased;
+  reallocations += other.reallocations;
+  scanned += other.scanned;
+  return *this;
+} // icarus::trigger::instrumentation::OperationCounters::operator+=()
+
+
+//------------------------------------------------------------------------------
+inline auto icarus::trigger::instrumentation::Counters::operator+=
+  (Counters const& other) -> Counters&
+{
+  for (std::size_t iOp = 0U; iOp < NOperations; ++iOp)
+    operations[iOp] += other.operations[iOp];
+  return *this;
+} // icarus::trigger::instrumentation::Counters::operator+=()
+
+
+//------------------------------------------------------------------------------
+inline auto icarus::trigger::instrumentation::threadCounters() -> Counters& {
+  static thread_local Counters counters;
+  return counters;
+} // icarus::trigger::instrumentation::threadCounters()
+
+
+//------------------------------------------------------------------------------
+inline void icarus::trigger::instrumentation::report
+  (std::ostream& out, Counters const& counters)
+{
+  out << std::setw(22) << "operation"
+    << std::setw(12) << "calls"
+    << std::setw(12) << "inserted"
+    << std::setw(12) << "erased"
+    << std::setw(12) << "realloc"
+    << std::setw(14) << "scanned"
+    << "\n";
+  for (std::size_t iOp = 0U; iOp < NOperations; ++iOp) {
+    OperationCounters const& opCounters = counters.operations[iOp];
+    out << std::setw(22) << name(static_cast<Operation>(iOp))
+      << std::setw(12) << opCounters.calls
+      << std::setw(12) << opCounters.inserted
+      << std::setw(12) << opCounters.erased
+      << std::setw(12) << opCounters.reallocations
+      << std::setw(14) << opCounters.scanned
+      << "\n";
+  } // for
+} // icarus::trigger::instrumentation::report()
+
+
+//------------------------------------------------------------------------------
+
+#endif // SBNOBJ_ICARUS_PMT_TRIGGER_DATA_TRIGGERGATEINSTRUMENTATION_H
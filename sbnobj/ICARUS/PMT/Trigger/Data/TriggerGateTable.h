@@ -0,0 +1,276 @@
+/**
+ * @file   sbnobj/ICARUS/PMT/Trigger/Data/TriggerGateTable.h
+ * @brief  Columnar storage of all the trigger gates of an event.
+ * @see    `sbnobj/ICARUS/PMT/Trigger/Data/TriggerGateTable.tcc`
+ * 
+ * This is a header-only library.
+ */
+ 
+#ifndef SBNOBJ_ICARUS_PMT_TRIGGER_DATA_TRIGGERGATETABLE_H
+#define SBNOBJ_ICARUS_PMT_TRIGGER_DATA_TRIGGERGATETABLE_H
+
+
+// ICARUS libraries
+#include "sbnobj/ICARUS/PMT/Trigger/Data/OpticalTriggerGate.h" // TriggerGateTick_t
+#include "sbnobj/ICARUS/PMT/Trigger/Data/TriggerGateView.h"
+#include "sbnobj/ICARUS/PMT/Trigger/Data/TriggerGateData.h"
+
+// LArSoft libraries
+#include "larcorealg/CoreUtils/span.h"
+#include "lardataobj/RawData/OpDetWaveform.h" // raw::Channel_t
+
+// C/C++ standard libraries
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+namespace icarus::trigger {
+  
+  template <typename Tick, typename TickInterval, typename ChannelIDType>
+  class TriggerGateTable;
+  
+  /// Type of gate table serialized into _art_ data products.
+  using OpticalTriggerGateTable_t = TriggerGateTable
+    <TriggerGateTick_t, TriggerGateTicks_t, raw::Channel_t>;
+    
+} // namespace icarus::trigger
+
+
+//------------------------------------------------------------------------------
+/**
+ * @brief Table of trigger gates with all their statuses in contiguous memory.
+ * @tparam Tick type used to count the ticks
+ * @tparam TickInterval type used to quantify tick difference
+ * @tparam ChannelIDType type of channel ID
+ * 
+ * This object holds the same information as a collection of
+ * `ReadoutTriggerGate` objects (e.g. all the `OpticalTriggerGateData_t` of an
+ * event), but instead of having each gate own its statuses and its channels,
+ * all the statuses of all the gates are stored one after the other in a single
+ * buffer, and all the channels in another one. Gate _i_ owns the statuses
+ * from `fStatusOffsets[i]` to `fStatusOffsets[i + 1]` (excluded), and its
+ * channels are similarly delimited by `fChannelOffsets` (in the jargon, this is
+ * a "compressed sparse row" layout).
+ * 
+ * The gates can't be changed after they are added: the table is filled once
+ * (`addGate()`, `fromGates()`), and then each gate is accessed via a
+ * `TriggerGateView` (`gate()`). New tables can be created combining the gates
+ * of an existing one (`combineGroups()`): the combination of an arbitrary
+ * number of gates is performed in a single sweep, without temporary gates.
+ * 
+ * The table is a valid _art_ data product: `OpticalTriggerGateTable_t` is
+ * the type with the same parameters as `OpticalTriggerGateData_t`.
+ * 
+ * 
+ * Example of usage, with a collection `gates` of `OpticalTriggerGateData_t`:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * auto const table
+ *   = icarus::trigger::OpticalTriggerGateTable_t::fromGates(gates);
+ * 
+ * // combine the gates in pairs, summing them
+ * std::vector<std::vector<std::size_t>> const pairs
+ *   { { 0U, 1U }, { 2U, 3U }, { 4U, 5U } };
+ * auto const pairTable = table.sumGroups(pairs);
+ * for (std::size_t iPair = 0U; iPair < pairTable.nGates(); ++iPair) {
+ *   if (pairTable.gate(iPair).findOpen(2U) != pairTable.MaxTick)
+ *     std::cout << "Gate pair #" << iPair << " has coincidences." << std::endl;
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+template <typename Tick, typename TickInterval, typename ChannelIDType>
+class icarus::trigger::TriggerGateTable {
+  
+  /// Type of the single gate in the table.
+  using GateData_t = icarus::trigger::TriggerGateData<Tick, TickInterval>;
+  
+    public:
+  
+  using ClockTick_t = Tick; ///< Tick point.
+  using ClockTicks_t = TickInterval; ///< Tick interval.
+  using ChannelID_t = ChannelIDType; ///< Type of stored channel ID.
+  
+  /// Type of count of number of open channels.
+  using OpeningCount_t = typename GateData_t::OpeningCount_t;
+  
+  /// Type of view of a single gate.
+  using GateView_t = typename GateData_t::GateView_t;
+  
+  /// Type of status of the gates.
+  using Status = typename GateView_t::Status;
+  
+  /// Type of list of channels of a single gate.
+  using ChannelSpan_t = util::span<ChannelID_t const*>;
+  
+  /// Type of index in the buffers.
+  using Offset_t = unsigned int;
+  
+  
+  /// An unbearably large tick number.
+  static constexpr ClockTick_t MaxTick = GateData_t::MaxTick;
+  
+  
+  /// Constructor: an empty table.
+  TriggerGateTable() = default;
+  
+  
+  // --- BEGIN Construction ----------------------------------------------------
+  /// @name Construction
+  /// @{
+  
+  /// Reserves memory for the specified number of gates, statuses and channels.
+  void reserve(std::size_t nGates, std::size_t nStatuses, std::size_t nChannels);
+  
+  /**
+   * @brief Adds a copy of a gate to the table.
+   * @tparam Channels type of collection of channel IDs
+   * @param gate the statuses of the gate to be added
+   * @param channels the channels associated to the gate
+   * @return the index of the new gate in the table
+   * 
+   * The statuses are stored compacted (see `TriggerGateData::compact()`).
+   */
+  template <typename Channels>
+  std::size_t addGate(GateView_t gate, Channels const& channels);
+  
+  /// Adds a copy of a `ReadoutTriggerGate`-like `gate`, with its channels.
+  template <typename Gate>
+  std::size_t addGate(Gate const& gate)
+    { return addGate(gate.view(), gate.channels()); }
+  
+  /// Returns a table with a copy of all the `gates`, in the same order.
+  template <typename Gates>
+  static TriggerGateTable fromGates(Gates const& gates);
+  
+  /// Removes all the gates.
+  void clear();
+  
+  /// @}
+  // --- END Construction ------------------------------------------------------
+  
+  
+  // --- BEGIN Access ----------------------------------------------------------
+  /// @name Access
+  /// @{
+  
+  /// Returns the number of gates in the table.
+  std::size_t nGates() const { return fStatusOffsets.size() - 1U; }
+  
+  /// Returns whether the table has no gates.
+  bool empty() const { return nGates() == 0U; }
+  
+  /// Returns the total number of statuses of all gates.
+  std::size_t nStatuses() const { return fStatuses.size(); }
+  
+  /// Returns a view of the gate with the specified `index` (no range check).
+  GateView_t gate(std::size_t index) const
+    {
+      return {
+        fStatuses.data() + fStatusOffsets[index],
+        fStatuses.data() + fStatusOffsets[index + 1U]
+        };
+    }
+  
+  /// Returns a view of the gate with the specified `index` (no range check).
+  GateView_t operator[] (std::size_t index) const { return gate(index); }
+  
+  /// Returns the channels of the gate with the specified `index`.
+  ChannelSpan_t channels(std::size_t index) const
+    {
+      return {
+        fChannels.data() + fChannelOffsets[index],
+        fChannels.data() + fChannelOffsets[index + 1U]
+        };
+    }
+  
+  /// Returns the index of the first gate with `channel`, `nGates()` if none.
+  std::size_t findGate(ChannelID_t channel) const;
+  
+  /// @}
+  // --- END Access ------------------------------------------------------------
+  
+  
+  // --- BEGIN Combination operations ------------------------------------------
+  /// @name Combination operations
+  /// @{
+  
+  /**
+   * @brief Returns a table with the combination of groups of gates.
+   * @tparam Op binary operation: `OpeningCount_t` (x2) to `OpeningCount_t`
+   * @tparam Groups a collection of collections of gate indices
+   * @param op symmetric and associative binary combination operation
+   * @param groups the indices of the gates to be combined into each new gate
+   * @return a table with one gate per group, in the same order
+   * 
+   * Each gate of the new table has, at each tick, the opening from the
+   * combination via `op` of the openings of all the gates in its group, and it
+   * is associated to all their channels.
+   * Each gate in a group is considered to have its first opening also before
+   * its first status; the combined gate starts at the earliest of the first
+   * statuses. An empty group yields a gate always closed.
+   * 
+   * All the groups are processed in a single pass each, merging the statuses
+   * of all the gates in the group at once.
+   */
+  template <typename Op, typename Groups>
+  TriggerGateTable combineGroups(Op op, Groups const& groups) const;
+  
+  /// Returns a table with gates summing the openings of each group of gates.
+  template <typename Groups>
+  TriggerGateTable sumGroups(Groups const& groups) const;
+  
+  /// Returns a table with gates with the maximum opening of each group.
+  template <typename Groups>
+  TriggerGateTable maxGroups(Groups const& groups) const;
+  
+  /// Returns a table with gates with the minimum opening of each group.
+  template <typename Groups>
+  TriggerGateTable minGroups(Groups const& groups) const;
+  
+  /// @}
+  // --- END Combination operations --------------------------------------------
+  
+  
+    private:
+  
+  /// Statuses of all the gates, one gate after the other.
+  std::vector<Status> fStatuses;
+  
+  /// Index of the first status of each gate, plus the total number.
+  std::vector<Offset_t> fStatusOffsets { 0U };
+  
+  /// Channels of all the gates, one gate after the other.
+  std::vector<ChannelID_t> fChannels;
+  
+  /// Index of the first channel of each gate, plus the total number.
+  std::vector<Offset_t> fChannelOffsets { 0U };
+  
+  
+  /// Working space of `combineGroups()`.
+  struct CombinationBuffers_t {
+    std::vector<Status const*> cursors; ///< Next status of each gate.
+    std::vector<Status const*> ends; ///< Past the last status of each gate.
+    std::vector<OpeningCount_t> levels; ///< Current opening of each gate.
+    std::vector<ChannelID_t> channels; ///< Channels of all the gates.
+  }; // CombinationBuffers_t
+  
+  /// Appends to this table the combination of the gates in `group` of
+  /// `source` table.
+  template <typename Op, typename Group>
+  void addCombination(
+    Op& op, TriggerGateTable const& source, Group const& group,
+    CombinationBuffers_t& buffers
+    );
+  
+}; // class icarus::trigger::TriggerGateTable
+
+
+//------------------------------------------------------------------------------
+//--- template implementation
+//------------------------------------------------------------------------------
+
+#include "sbnobj/ICARUS/PMT/Trigger/Data/TriggerGateTable.tcc"
+
+//------------------------------------------------------------------------------
+
+#endif // SBNOBJ_ICARUS_PMT_TRIGGER_DATA_TRIGGERGATETABLE_H
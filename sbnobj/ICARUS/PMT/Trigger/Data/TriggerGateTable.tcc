@@ -0,0 +1,251 @@
+/**
+ * @file   sbnobj/ICARUS/PMT/Trigger/Data/TriggerGateTable.tcc
+ * @brief  Columnar storage of all the trigger gates of an event.
+ * @see    sbnobj/ICARUS/PMT/Trigger/Data/TriggerGateTable.h
+ */
+ 
+#ifndef SBNOBJ_ICARUS_PMT_TRIGGER_DATA_TRIGGERGATETABLE_TCC
+#define SBNOBJ_ICARUS_PMT_TRIGGER_DATA_TRIGGERGATETABLE_TCC
+
+// C/C++ standard libraries
+#include <algorithm> // std::find(), std::upper_bound(), std::sort()...
+#include <iterator> // std::distance(), std::size()
+#include <functional> // std::plus<>
+#include <cassert>
+
+
+// make "sure" this header is not included directly
+#ifndef SBNOBJ_ICARUS_PMT_TRIGGER_DATA_TRIGGERGATETABLE_H
+# error "TriggerGateTable.tcc must not be directly included!"\
+        " #include \"sbnobj/ICARUS/PMT/Trigger/Data/TriggerGateTable.h\" instead."
+#endif // !SBNOBJ_ICARUS_PMT_TRIGGER_DATA_TRIGGERGATETABLE_H
+
+
+//------------------------------------------------------------------------------
+//--- template implementation
+//------------------------------------------------------------------------------
+template <typename Tick, typename TickInterval, typename ChannelIDType>
+void icarus::trigger::TriggerGateTable<Tick, TickInterval, ChannelIDType>::reserve
+  (std::size_t nGates, std::size_t nStatuses, std::size_t nChannels)
+{
+  fStatuses.reserve(nStatuses);
+  fStatusOffsets.reserve(nGates + 1U);
+  fChannels.reserve(nChannels);
+  fChannelOffsets.reserve(nGates + 1U);
+} // icarus::trigger::TriggerGateTable<>::reserve()
+
+
+//------------------------------------------------------------------------------
+template <typename Tick, typename TickInterval, typename ChannelIDType>
+template <typename Channels>
+std::size_t icarus::trigger::TriggerGateTable<Tick, TickInterval, ChannelIDType>::addGate
+  (GateView_t gate, Channels const& channels)
+{
+  // the gate is stored compacted, without the statuses `compact()` would remove
+  std::size_t iLastKept = fStatuses.size();
+  for (Status const& status: gate) {
+    if ((iLastKept < fStatuses.size())
+      && details::isRedundantGateStatus(fStatuses[iLastKept], status)
+    ) {
+      continue;
+    }
+    iLastKept = fStatuses.size();
+    fStatuses.push_back(status);
+  } // for
+  fStatusOffsets.push_back(static_cast<Offset_t>(fStatuses.size()));
+  fChannels.insert(fChannels.end(), std::begin(channels), std::end(channels));
+  fChannelOffsets.push_back(static_cast<Offset_t>(fChannels.size()));
+  return nGates() - 1U;
+} // icarus::trigger::TriggerGateTable<>::addGate()
+
+
+//------------------------------------------------------------------------------
+template <typename Tick, typename TickInterval, typename ChannelIDType>
+template <typename Gates>
+auto icarus::trigger::TriggerGateTable<Tick, TickInterval, ChannelIDType>::fromGates
+  (Gates const& gates) -> TriggerGateTable
+{
+  std::size_t nStatuses = 0U, nChannels = 0U;
+  for (auto const& gate: gates) {
+    nStatuses += gate.view().nStatuses();
+    nChannels += gate.nChannels();
+  }
+  
+  TriggerGateTable table;
+  table.reserve(std::size(gates), nStatuses, nChannels);
+  for (auto const& gate: gates) table.addGate(gate);
+  return table;
+} // icarus::trigger::TriggerGateTable<>::fromGates()
+
+
+//------------------------------------------------------------------------------
+template <typename Tick, typename TickInterval, typename ChannelIDType>
+void icarus::trigger::TriggerGateTable<Tick, TickInterval, ChannelIDType>::clear()
+{
+  fStatuses.clear();
+  fStatusOffsets.assign(1U, 0U);
+  fChannels.clear();
+  fChannelOffsets.assign(1U, 0U);
+} // icarus::trigger::TriggerGateTable<>::clear()
+
+
+//------------------------------------------------------------------------------
+template <typename Tick, typename TickInterval, typename ChannelIDType>
+std::size_t icarus::trigger::TriggerGateTable<Tick, TickInterval, ChannelIDType>::findGate
+  (ChannelID_t channel) const
+{
+  auto const cbegin = fChannels.cbegin();
+  auto const iChannel = std::find(cbegin, fChannels.cend(), channel);
+  if (iChannel == fChannels.cend()) return nGates();
+  
+  // the gate is the last one starting at or before the channel
+  auto const channelIndex
+    = static_cast<Offset_t>(std::distance(cbegin, iChannel));
+  auto const iOffset = std::upper_bound
+    (fChannelOffsets.cbegin(), fChannelOffsets.cend(), channelIndex);
+  return std::distance(fChannelOffsets.cbegin(), iOffset) - 1U;
+} // icarus::trigger::TriggerGateTable<>::findGate()
+
+
+//------------------------------------------------------------------------------
+template <typename Tick, typename TickInterval, typename ChannelIDType>
+template <typename Op, typename Groups>
+auto icarus::trigger::TriggerGateTable<Tick, TickInterval, ChannelIDType>::combineGroups
+  (Op op, Groups const& groups) const -> TriggerGateTable
+{
+  TriggerGateTable combined;
+  combined.fStatusOffsets.reserve(std::size(groups) + 1U);
+  combined.fChannelOffsets.reserve(std::size(groups) + 1U);
+  // the combination usually has fewer statuses than all the gates together
+  combined.fStatuses.reserve(fStatuses.size());
+  
+  CombinationBuffers_t buffers; // reused for all groups
+  for (auto const& group: groups)
+    combined.addCombination(op, *this, group, buffers);
+  
+  return combined;
+} // icarus::trigger::TriggerGateTable<>::combineGroups()
+
+
+//------------------------------------------------------------------------------
+template <typename Tick, typename TickInterval, typename ChannelIDType>
+template <typename Groups>
+auto icarus::trigger::TriggerGateTable<Tick, TickInterval, ChannelIDType>::sumGroups
+  (Groups const& groups) const -> TriggerGateTable
+{
+  return combineGroups(std::plus<OpeningCount_t>(), groups);
+} // icarus::trigger::TriggerGateTable<>::sumGroups()
+
+
+//------------------------------------------------------------------------------
+template <typename Tick, typename TickInterval, typename ChannelIDType>
+template <typename Groups>
+auto icarus::trigger::TriggerGateTable<Tick, TickInterval, ChannelIDType>::maxGroups
+  (Groups const& groups) const -> TriggerGateTable
+{
+  return combineGroups
+    ([](OpeningCount_t a, OpeningCount_t b){ return std::max(a, b); }, groups);
+} // icarus::trigger::TriggerGateTable<>::maxGroups()
+
+
+//------------------------------------------------------------------------------
+template <typename Tick, typename TickInterval, typename ChannelIDType>
+template <typename Groups>
+auto icarus::trigger::TriggerGateTable<Tick, TickInterval, ChannelIDType>::minGroups
+  (Groups const& groups) const -> TriggerGateTable
+{
+  return combineGroups
+    ([](OpeningCount_t a, OpeningCount_t b){ return std::min(a, b); }, groups);
+} // icarus::trigger::TriggerGateTable<>::minGroups()
+
+
+//------------------------------------------------------------------------------
+template <typename Tick, typename TickInterval, typename ChannelIDType>
+template <typename Op, typename Group>
+void icarus::trigger::TriggerGateTable<Tick, TickInterval, ChannelIDType>::addCombination(
+  Op& op, TriggerGateTable const& source, Group const& group,
+  CombinationBuffers_t& buffers
+) {
+  /*
+   * All the gates of the group are swept together in tick order: a cursor
+   * points to the next status of each gate, and at each tick all the gates
+   * with a status there update their opening level; the combined level is
+   * recorded only when it changes, so that the result is already compact.
+   */
+  using EventType = details::TriggerGateEventType;
+  
+  auto& [ cursors, ends, levels, channels ] = buffers;
+  cursors.clear();
+  ends.clear();
+  levels.clear();
+  channels.clear();
+  
+  ClockTick_t startTick = MaxTick;
+  for (std::size_t const index: group) {
+    GateView_t const gate = source.gate(index);
+    assert(!gate.empty());
+    cursors.push_back(gate.begin() + 1);
+    ends.push_back(gate.end());
+    levels.push_back(gate.begin()->opening);
+    startTick = std::min(startTick, gate.begin()->tick);
+    
+    ChannelSpan_t const gateChannels = source.channels(index);
+    channels.insert(channels.end(), gateChannels.begin(), gateChannels.end());
+  } // for gates in group
+  
+  auto const combinedLevel = [&op,&levels]()
+    {
+      OpeningCount_t level = levels.front();
+      for (auto iLevel = levels.cbegin() + 1; iLevel != levels.cend(); ++iLevel)
+        level = op(level, *iLevel);
+      return level;
+    };
+  
+  if (levels.empty()) { // empty group: closed gate with no channels
+    fStatuses.emplace_back(EventType::Set, GateData_t::MinTick, 0U);
+  }
+  else {
+    OpeningCount_t level = combinedLevel();
+    fStatuses.emplace_back(EventType::Set, startTick, level);
+    
+    std::size_t const nGates = cursors.size();
+    while (true) {
+    
+      // find the next tick with any change
+      bool atEnd = true;
+      ClockTick_t tick = MaxTick;
+      for (std::size_t iGate = 0U; iGate < nGates; ++iGate) {
+        if (cursors[iGate] == ends[iGate]) continue;
+        if (atEnd || (cursors[iGate]->tick < tick)) tick = cursors[iGate]->tick;
+        atEnd = false;
+      } // for
+      if (atEnd) break;
+      
+      // apply all the changes at that tick
+      for (std::size_t iGate = 0U; iGate < nGates; ++iGate) {
+        Status const*& cursor = cursors[iGate];
+        while ((cursor != ends[iGate]) && (cursor->tick == tick))
+          levels[iGate] = (cursor++)->opening;
+      } // for
+      
+      OpeningCount_t const newLevel = combinedLevel();
+      if (newLevel == level) continue;
+      fStatuses.emplace_back(EventType::Shift, tick, newLevel);
+      level = newLevel;
+    
+    } // while
+  } // if ... else
+  fStatusOffsets.push_back(static_cast<Offset_t>(fStatuses.size()));
+  
+  // channels are sorted and unique, like in `ReadoutTriggerGate`
+  std::sort(channels.begin(), channels.end());
+  auto const channelEnd = std::unique(channels.begin(), channels.end());
+  fChannels.insert(fChannels.end(), channels.begin(), channelEnd);
+  fChannelOffsets.push_back(static_cast<Offset_t>(fChannels.size()));
+  
+} // icarus::trigger::TriggerGateTable<>::addCombination()
+
+
+//------------------------------------------------------------------------------
+
+#endif // SBNOBJ_ICARUS_PMT_TRIGGER_DATA_TRIGGERGATETABLE_TCC
@@ -0,0 +1,242 @@
+/**
+ * @file   sbnobj/ICARUS/PMT/Trigger/Data/TriggerGateView.h
+ * @brief  Read-only view of the statuses of a logical multilevel gate.
+ * @see    `sbnobj/ICARUS/PMT/Trigger/Data/TriggerGateData.h`
+ * 
+ * This is a header only library.
+ * 
+ */
+ 
+#ifndef SBNOBJ_ICARUS_PMT_TRIGGER_DATA_TRIGGERGATEVIEW_H
+#define SBNOBJ_ICARUS_PMT_TRIGGER_DATA_TRIGGERGATEVIEW_H
+
+// ICARUS libraries
+#include "sbnobj/ICARUS/PMT/Trigger/Data/TriggerGateData.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::upper_bound()
+#include <iterator> // std::prev()
+#include <limits>
+#include <cstddef> // std::size_t
+#include <cassert>
+
+
+//------------------------------------------------------------------------------
+/**
+ * @brief Read-only view of the statuses of a multi-level gate.
+ * @tparam Tick type used to count the ticks
+ * @tparam OpeningCount type of count of number of open channels
+ * @see `icarus::trigger::TriggerGateData`
+ * 
+ * The view refers to a contiguous sequence of gate statuses owned by someone
+ * else, like a `TriggerGateData` object (see `TriggerGateData::view()`) or a
+ * `TriggerGateTable`. The view must not outlive the owner of the statuses,
+ * and it is invalidated by any change of them.
+ * 
+ * The queries behave like the ones of `TriggerGateData` with the same name.
+ */
+template <typename Tick, typename OpeningCount /* = unsigned int */>
+class icarus::trigger::TriggerGateView {
+    
+    public:
+  
+  using ClockTick_t = Tick; ///< Type of a point in time, measured in ticks.
+  
+  /// Type of count of number of open channels.
+  using OpeningCount_t = OpeningCount;
+  
+  /// Type of the gate status.
+  using Status = details::TriggerGateStatus<ClockTick_t, OpeningCount_t>;
+  
+  /// Type of iterator to the statuses.
+  using const_iterator = Status const*;
+  
+  
+  /// An unbearably small tick number.
+  static constexpr ClockTick_t MinTick
+    = std::numeric_limits<ClockTick_t>::min();
+  
+  /// An unbearably large tick number.
+  static constexpr ClockTick_t MaxTick
+    = std::numeric_limits<ClockTick_t>::max();
+  
+  
+  /// Constructor: an empty view.
+  TriggerGateView() = default;
+  
+  /// Constructor: views the statuses from `begin` to `end` (excluded).
+  TriggerGateView(Status const* begin, Status const* end)
+    : fBegin(begin), fEnd(end) {}
+  
+  
+  // --- BEGIN Status access ---------------------------------------------------
+  /// @name Status access
+  /// @{
+  
+  /// Returns the number of statuses in the view.
+  std::size_t nStatuses() const { return fEnd - fBegin; }
+  
+  /// Returns whether there is no status in the view at all.
+  bool empty() const { return fBegin == fEnd; }
+  
+  /// Returns an iterator to the first status.
+  const_iterator begin() const { return fBegin; }
+  
+  /// Returns an iterator past the last status.
+  const_iterator end() const { return fEnd; }
+  
+  /// Returns the status with the specified index (no range check).
+  Status const& operator[] (std::size_t index) const { return fBegin[index]; }
+  
+  /// @}
+  // --- END Status access -----------------------------------------------------
+  
+  
+  // --- BEGIN Query -----------------------------------------------------------
+  /// @name Query
+  /// @{
+  
+  /// Returns the tick of the last gate change.
+  ClockTick_t lastTick() const
+    { assert(!empty()); return std::prev(fEnd)->tick; }
+  
+  /// Returns the opening count of the gate at the specified `tick`.
+  /// The gate is considered closed before its first status.
+  OpeningCount_t openingCount(ClockTick_t tick) const;
+  
+  /// Returns whether the gate is open at all at the specified `tick`.
+  bool isOpen(ClockTick_t tick) const { return openingCount(tick) > 0U; }
+  
+  /// Returns whether this gate never opened.
+  bool alwaysClosed() const { return findOpenStatus(1U) == fEnd; }
+  
+  /// Returns the tick at which the gate opened (see
+  /// `TriggerGateData::findOpen()`).
+  ClockTick_t findOpen(
+    OpeningCount_t minOpening = 1U,
+    ClockTick_t start = MinTick, ClockTick_t end = MaxTick
+    ) const;
+  
+  /// Returns the tick at which the gate closed (see
+  /// `TriggerGateData::findClose()`).
+  ClockTick_t findClose(
+    OpeningCount_t minOpening = 1U,
+    ClockTick_t start = MinTick, ClockTick_t end = MaxTick
+    ) const;
+  
+  /// @}
+  // --- END Query -------------------------------------------------------------
+  
+  
+    private:
+  
+  Status const* fBegin = nullptr; ///< The first status.
+  Status const* fEnd = nullptr; ///< Past the last status.
+  
+  /// Returns the first status for which `op(status)` is true, or `end()`,
+  /// ignoring the statuses which gate compaction would remove.
+  template <typename Op>
+  const_iterator findStatus
+    (Op op, ClockTick_t start = MinTick, ClockTick_t end = MaxTick) const;
+  
+  /// Returns the first status with at least `minOpening` opening count.
+  const_iterator findOpenStatus(
+    OpeningCount_t minOpening,
+    ClockTick_t start = MinTick, ClockTick_t end = MaxTick
+    ) const;
+  
+}; // class icarus::trigger::TriggerGateView<>
+
+
+//------------------------------------------------------------------------------
+//---  Template implementation
+//------------------------------------------------------------------------------
+template <typename Tick, typename OpeningCount>
+auto icarus::trigger::TriggerGateView<Tick, OpeningCount>::openingCount
+  (ClockTick_t tick) const -> OpeningCount_t
+{
+  auto const iStatus = std::upper_bound(fBegin, fEnd, tick,
+    [](ClockTick_t tick, Status const& status){ return tick < status.tick; }
+    );
+  return (iStatus == fBegin)? OpeningCount_t{ 0 }: std::prev(iStatus)->opening;
+} // icarus::trigger::TriggerGateView<>::openingCount()
+
+
+//------------------------------------------------------------------------------
+template <typename Tick, typename OpeningCount>
+auto icarus::trigger::TriggerGateView<Tick, OpeningCount>::findOpen(
+  OpeningCount_t minOpening /* = 1U */,
+  ClockTick_t start /* = MinTick */, ClockTick_t end /* = MaxTick */
+) const -> ClockTick_t
+{
+  auto const iStatus = findOpenStatus(minOpening, start, end);
+  return (iStatus == fEnd)? end: iStatus->tick;
+} // icarus::trigger::TriggerGateView<>::findOpen()
+
+
+//------------------------------------------------------------------------------
+template <typename Tick, typename OpeningCount>
+auto icarus::trigger::TriggerGateView<Tick, OpeningCount>::findClose(
+  OpeningCount_t minOpening /* = 1U */,
+  ClockTick_t start /* = MinTick */, ClockTick_t end /* = MaxTick */
+) const -> ClockTick_t
+{
+  auto const isClose
+    = [minOpening](Status const& status){ return status.opening < minOpening; };
+  auto const iStatus = findStatus(isClose, start, end);
+  return (iStatus == fEnd)? end: iStatus->tick;
+} // icarus::trigger::TriggerGateView<>::findClose()
+
+
+//------------------------------------------------------------------------------
+template <typename Tick, typename OpeningCount>
+template <typename Op>
+auto icarus::trigger::TriggerGateView<Tick, OpeningCount>::findStatus
+  (Op op, ClockTick_t start /* = MinTick */, ClockTick_t end /* = MaxTick */)
+  const -> const_iterator
+{
+  using EventType = details::TriggerGateEventType;
+  
+  // the first status at or after `start`
+  auto iStatus = std::upper_bound(fBegin, fEnd, start,
+    [](ClockTick_t tick, Status const& status){ return tick < status.tick; }
+    );
+  if ((iStatus != fBegin) && (std::prev(iStatus)->tick == start)) --iStatus;
+  
+  // statuses which gate compaction would remove are skipped
+  Status const* pLastKept = (iStatus == fBegin)? nullptr: std::prev(iStatus);
+  for (; iStatus != fEnd; ++iStatus) {
+    if (iStatus->tick >= end) break;
+    if (pLastKept && details::isRedundantGateStatus(*pLastKept, *iStatus))
+      continue;
+    pLastKept = iStatus;
+    if (iStatus->event == EventType::Unknown) continue;
+    if (op(*iStatus)) return iStatus;
+  } // for
+  return fEnd;
+} // icarus::trigger::TriggerGateView<>::findStatus()
+
+
+//------------------------------------------------------------------------------
+template <typename Tick, typename OpeningCount>
+auto icarus::trigger::TriggerGateView<Tick, OpeningCount>::findOpenStatus(
+  OpeningCount_t minOpening,
+  ClockTick_t start /* = MinTick */, ClockTick_t end /* = MaxTick */
+) const -> const_iterator
+{
+  auto const isOpen
+    = [minOpening](Status const& status){ return status.opening >= minOpening; }
+    ;
+  return findStatus(isOpen, start, end);
+} // icarus::trigger::TriggerGateView<>::findOpenStatus()
+
+
+//------------------------------------------------------------------------------
+template <typename TK, typename TI>
+auto icarus::trigger::TriggerGateData<TK, TI>::view() const -> GateView_t
+  { return { fGateLevel.data(), fGateLevel.data() + fGateLevel.size() }; }
+
+
+//------------------------------------------------------------------------------
+
+#endif // SBNOBJ_ICARUS_PMT_TRIGGER_DATA_TRIGGERGATEVIEW_H
@@ -0,0 +1,164 @@
+/**
+ * @file   sbnobj/ICARUS/PMT/Trigger/Data/WaveformDiscriminator.cxx
+ * @brief  Threshold discrimination of optical waveforms into trigger gates.
+ * @see    `sbnobj/ICARUS/PMT/Trigger/Data/WaveformDiscriminator.h`
+ * 
+ */
+
+// library header
+#include "sbnobj/ICARUS/PMT/Trigger/Data/WaveformDiscriminator.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::min()
+#include <limits>
+#include <cmath> // std::floor()
+#include <cassert>
+
+
+//------------------------------------------------------------------------------
+//--- icarus::trigger::WaveformDiscriminator
+//------------------------------------------------------------------------------
+auto icarus::trigger::WaveformDiscriminator::thresholdLevel
+  (icarus::WaveformBaseline const& baseline) const -> ADCCount_t
+{
+  // negative polarity: beyond threshold means below `baseline - threshold`
+  float const level = std::floor(baseline() - fThreshold);
+  
+  constexpr float MinLevel = std::numeric_limits<ADCCount_t>::min();
+  constexpr float MaxLevel = std::numeric_limits<ADCCount_t>::max();
+  return static_cast<ADCCount_t>(std::min(std::max(level, MinLevel), MaxLevel));
+  
+} // icarus::trigger::WaveformDiscriminator::thresholdLevel()
+
+
+//------------------------------------------------------------------------------
+auto icarus::trigger::WaveformDiscriminator::findOpenIntervals(
+  ADCCount_t const* samples, std::size_t nSamples, ADCCount_t level,
+  ClockTick_t firstTick
+) -> TickIntervals_t
+{
+  TickIntervals_t intervals;
+  
+  bool open = false; // whether the gate is open at the current sample
+  ClockTick_t openTick = firstTick;
+  
+  std::size_t iSample = 0U;
+  while (iSample < nSamples) {
+  
+    std::size_t const iBlockEnd = std::min(iSample + BlockSize, nSamples);
+    
+    // if the block is all on the same side of the threshold as the current
+    // gate status, there is no crossing in it and we skip it entirely
+    std::size_t const nBeyond
+      = countBeyond(samples + iSample, samples + iBlockEnd, level);
+    if (nBeyond == (open? (iBlockEnd - iSample): 0U)) {
+      iSample = iBlockEnd;
+      continue;
+    }
+    
+    for (; iSample < iBlockEnd; ++iSample) {
+      bool const beyond = (samples[iSample] <= level);
+      if (beyond == open) continue;
+      
+      ClockTick_t const tick = firstTick + static_cast<ClockTick_t>(iSample);
+      if (beyond) openTick = tick;
+      else        intervals.emplace_back(openTick, tick);
+      open = beyond;
+    } // for samples in block
+  
+  } // while
+  
+  if (open) {
+    intervals.emplace_back
+      (openTick, firstTick + static_cast<ClockTick_t>(nSamples));
+  }
+  
+  return intervals;
+} // icarus::trigger::WaveformDiscriminator::findOpenIntervals()
+
+
+//------------------------------------------------------------------------------
+auto icarus::trigger::WaveformDiscriminator::findOpenIntervals(
+  raw::OpDetWaveform const& waveform,
+  icarus::WaveformBaseline const& baseline,
+  ClockTick_t firstTick
+) const -> TickIntervals_t
+{
+  return findOpenIntervals
+    (waveform.data(), waveform.size(), thresholdLevel(baseline), firstTick);
+} // icarus::trigger::WaveformDiscriminator::findOpenIntervals()
+
+
+//------------------------------------------------------------------------------
+auto icarus::trigger::WaveformDiscriminator::operator() (
+  raw::OpDetWaveform const& waveform,
+  icarus::WaveformBaseline const& baseline,
+  ClockTick_t firstTick
+) const -> Gate_t
+{
+  Gate_t gate { waveform };
+  gate.openInIntervals(findOpenIntervals(waveform, baseline, firstTick));
+  return gate;
+} // icarus::trigger::WaveformDiscriminator::operator()
+
+
+//------------------------------------------------------------------------------
+void icarus::trigger::WaveformDiscriminator::discriminate(
+  std::vector<Gate_t>& gates,
+  std::vector<raw::OpDetWaveform> const& waveforms,
+  std::vector<icarus::WaveformBaseline> const& baselines,
+  std::vector<ClockTick_t> const& firstTicks,
+  std::size_t begin, std::size_t end
+) const {
+  
+  assert(gates.size() == waveforms.size());
+  assert(baselines.size() == waveforms.size());
+  assert(firstTicks.size() == waveforms.size());
+  assert(end <= waveforms.size());
+  
+  for (std::size_t iWaveform = begin; iWaveform < end; ++iWaveform) {
+    gates[iWaveform].openInIntervals(findOpenIntervals
+      (waveforms[iWaveform], baselines[iWaveform], firstTicks[iWaveform])
+      );
+  } // for
+  
+} // icarus::trigger::WaveformDiscriminator::discriminate()
+
+
+//------------------------------------------------------------------------------
+auto icarus::trigger::WaveformDiscriminator::discriminate(
+  std::vector<raw::OpDetWaveform> const& waveforms,
+  std::vector<icarus::WaveformBaseline> const& baselines,
+  std::vector<ClockTick_t> const& firstTicks
+) const -> std::vector<Gate_t>
+{
+  std::vector<Gate_t> gates = makeGates(waveforms);
+  discriminate(gates, waveforms, baselines, firstTicks, 0U, waveforms.size());
+  return gates;
+} // icarus::trigger::WaveformDiscriminator::discriminate()
+
+
+//------------------------------------------------------------------------------
+auto icarus::trigger::WaveformDiscriminator::makeGates
+  (std::vector<raw::OpDetWaveform> const& waveforms) -> std::vector<Gate_t>
+{
+  std::vector<Gate_t> gates;
+  gates.reserve(waveforms.size());
+  for (raw::OpDetWaveform const& waveform: waveforms)
+    gates.emplace_back(waveform);
+  return gates;
+} // icarus::trigger::WaveformDiscriminator::makeGates()
+
+
+//------------------------------------------------------------------------------
+std::size_t icarus::trigger::WaveformDiscriminator::countBeyond
+  (ADCCount_t const* samples, ADCCount_t const* send, ADCCount_t level)
+{
+  // simple enough for the compiler to vectorize
+  std::size_t n = 0U;
+  for (; samples != send; ++samples) n += (*samples <= level);
+  return n;
+} // icarus::trigger::WaveformDiscriminator::countBeyond()
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,222 @@
+/**
+ * @file   sbnobj/ICARUS/PMT/Trigger/Data/WaveformDiscriminator.h
+ * @brief  Threshold discrimination of optical waveforms into trigger gates.
+ * @see    `sbnobj/ICARUS/PMT/Trigger/Data/WaveformDiscriminator.cxx`
+ * 
+ */
+
+#ifndef SBNOBJ_ICARUS_PMT_TRIGGER_DATA_WAVEFORMDISCRIMINATOR_H
+#define SBNOBJ_ICARUS_PMT_TRIGGER_DATA_WAVEFORMDISCRIMINATOR_H
+
+
+// ICARUS libraries
+#include "sbnobj/ICARUS/PMT/Trigger/Data/SingleChannelOpticalTriggerGate.h"
+#include "sbnobj/ICARUS/PMT/Trigger/Data/OpticalTriggerGate.h" // TriggerGateTick_t
+#include "sbnobj/ICARUS/PMT/Data/WaveformBaseline.h"
+
+// SBN libraries
+#include "sbnobj/Common/PMT/Data/V1730channelConfiguration.h"
+
+// LArSoft libraries
+#include "lardataobj/RawData/OpDetWaveform.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <utility> // std::pair
+#include <cstddef> // std::size_t
+
+
+//------------------------------------------------------------------------------
+namespace icarus::trigger { class WaveformDiscriminator; }
+/**
+ * @brief Discriminates optical waveforms against a threshold.
+ * 
+ * The discriminator turns the samples of a `raw::OpDetWaveform` into a
+ * `SingleChannelOpticalTriggerGate` which is open (opening count `1`) for all
+ * the ticks where the waveform is beyond threshold.
+ * 
+ * The threshold is specified relative to the baseline of the waveform, and
+ * the polarity of the signal is assumed negative as in ICARUS PMT readout:
+ * a sample is beyond threshold if it is at least `threshold()` ADC counts
+ * _below_ the baseline. This is the same convention as
+ * `sbn::V1730channelConfiguration::relativeThreshold()`, and a discriminator
+ * with the hardware threshold of a channel can be obtained via
+ * `fromConfiguration()`.
+ * 
+ * The gate opens at the first sample beyond threshold and closes at the first
+ * sample which is not beyond threshold anymore. A gate still open at the end
+ * of the waveform is closed one tick after the last sample.
+ * 
+ * The time of the first sample of the waveform, in optical ticks, needs to be
+ * provided by the caller, since its conversion requires detector timing
+ * information not available here.
+ * 
+ * 
+ * Performance notes
+ * ------------------
+ * 
+ * Samples are processed in blocks of `BlockSize`. For each block, the number of
+ * samples beyond threshold is first counted with a simple reduction loop which
+ * the compiler can vectorize; only blocks whose count shows a threshold
+ * crossing are scanned sample by sample. The resulting intervals are appended
+ * to the gate in bulk via `TriggerGateData::openInIntervals()`.
+ * 
+ * The discriminator holds no state besides its threshold, and all its
+ * methods are `const`: it can be used concurrently from multiple threads.
+ * The processing of a full event can be split by the caller into ranges of
+ * waveforms, each handled by `discriminate()` in parallel, e.g. with TBB:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * icarus::trigger::WaveformDiscriminator const discr { 20 };
+ * auto gates = icarus::trigger::WaveformDiscriminator::makeGates(waveforms);
+ * tbb::parallel_for(tbb::blocked_range<std::size_t>{ 0U, waveforms.size() },
+ *   [&](tbb::blocked_range<std::size_t> const& r)
+ *     {
+ *       discr.discriminate
+ *         (gates, waveforms, baselines, firstTicks, r.begin(), r.end());
+ *     }
+ *   );
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class icarus::trigger::WaveformDiscriminator {
+    
+    public:
+  
+  /// Type of ADC sample and of threshold.
+  using ADCCount_t = raw::ADC_Count_t;
+  
+  /// Type of tick of the produced gates.
+  using ClockTick_t = icarus::trigger::TriggerGateTick_t;
+  
+  /// Type of gate produced by the discriminator.
+  using Gate_t = icarus::trigger::SingleChannelOpticalTriggerGate;
+  
+  /// An interval of ticks, `{ start, end }` (the `end` tick is excluded).
+  using TickInterval_t = std::pair<ClockTick_t, ClockTick_t>;
+  
+  /// A list of tick intervals.
+  using TickIntervals_t = std::vector<TickInterval_t>;
+  
+  /// Number of samples processed together in a block.
+  static constexpr std::size_t BlockSize = 64U;
+  
+  
+  /// Constructor: sets the `threshold` (ADC counts below baseline).
+  explicit WaveformDiscriminator(ADCCount_t threshold)
+    : fThreshold{ threshold } {}
+  
+  /// Returns a discriminator with the hardware threshold of the channel.
+  static WaveformDiscriminator fromConfiguration
+    (sbn::V1730channelConfiguration const& config)
+    { return WaveformDiscriminator{ config.relativeThreshold() }; }
+  
+  
+  /// Returns the threshold, as ADC counts below the baseline.
+  ADCCount_t threshold() const { return fThreshold; }
+  
+  /// Returns the largest sample value beyond threshold with this `baseline`.
+  ADCCount_t thresholdLevel(icarus::WaveformBaseline const& baseline) const;
+  
+  
+  // --- BEGIN -- Discrimination -----------------------------------------------
+  /// @name Discrimination
+  /// @{
+  
+  /**
+   * @brief Returns the tick intervals where the samples are beyond threshold.
+   * @param samples pointer to the first sample
+   * @param nSamples number of samples
+   * @param level largest value of a sample beyond threshold
+   * @param firstTick tick of the first sample
+   * @return sorted list of disjoint intervals with samples beyond threshold
+   * @see `thresholdLevel()`
+   */
+  static TickIntervals_t findOpenIntervals(
+    ADCCount_t const* samples, std::size_t nSamples, ADCCount_t level,
+    ClockTick_t firstTick
+    );
+  
+  /**
+   * @brief Returns the tick intervals where `waveform` is beyond threshold.
+   * @param waveform the waveform to be discriminated
+   * @param baseline the baseline of `waveform`
+   * @param firstTick tick of the first sample of `waveform`
+   * @return sorted list of disjoint intervals with samples beyond threshold
+   */
+  TickIntervals_t findOpenIntervals(
+    raw::OpDetWaveform const& waveform,
+    icarus::WaveformBaseline const& baseline,
+    ClockTick_t firstTick
+    ) const;
+  
+  /**
+   * @brief Returns the gate of the discriminated `waveform`.
+   * @param waveform the waveform to be discriminated
+   * @param baseline the baseline of `waveform`
+   * @param firstTick tick of the first sample of `waveform`
+   * @return a gate on the channel of `waveform`, open beyond threshold
+   */
+  Gate_t operator() (
+    raw::OpDetWaveform const& waveform,
+    icarus::WaveformBaseline const& baseline,
+    ClockTick_t firstTick
+    ) const;
+  
+  /**
+   * @brief Discriminates a range of waveforms into the matching gates.
+   * @param gates the gates to be filled, one per waveform
+   * @param waveforms the waveforms to be discriminated
+   * @param baselines the baseline of each of the `waveforms`
+   * @param firstTicks the tick of the first sample of each of the `waveforms`
+   * @param begin index of the first waveform to discriminate
+   * @param end index after the last waveform to discriminate
+   * @see `makeGates()`
+   * 
+   * The gates with index from `begin` to `end` (excluded) are opened according
+   * to the waveform with the same index. The gates need to be already
+   * associated to the proper waveform, e.g. via `makeGates()`. No other gate
+   * is touched, so that different ranges can be processed concurrently.
+   */
+  void discriminate(
+    std::vector<Gate_t>& gates,
+    std::vector<raw::OpDetWaveform> const& waveforms,
+    std::vector<icarus::WaveformBaseline> const& baselines,
+    std::vector<ClockTick_t> const& firstTicks,
+    std::size_t begin, std::size_t end
+    ) const;
+  
+  /**
+   * @brief Returns the gates from all the `waveforms`.
+   * @param waveforms the waveforms to be discriminated
+   * @param baselines the baseline of each of the `waveforms`
+   * @param firstTicks the tick of the first sample of each of the `waveforms`
+   * @return a gate for each waveform, in the same order
+   */
+  std::vector<Gate_t> discriminate(
+    std::vector<raw::OpDetWaveform> const& waveforms,
+    std::vector<icarus::WaveformBaseline> const& baselines,
+    std::vector<ClockTick_t> const& firstTicks
+    ) const;
+  
+  /// @}
+  // --- END ---- Discrimination -----------------------------------------------
+  
+  
+  /// Returns a closed gate for each of the `waveforms`, in the same order.
+  static std::vector<Gate_t> makeGates
+    (std::vector<raw::OpDetWaveform> const& waveforms);
+    
+    
+    private:
+  
+  ADCCount_t fThreshold; ///< Threshold, in ADC counts below the baseline.
+  
+  /// Returns how many `samples` up to `send` are not larger than `level`.
+  static std::size_t countBeyond
+    (ADCCount_t const* samples, ADCCount_t const* send, ADCCount_t level);
+  
+}; // class icarus::trigger::WaveformDiscriminator
+
+
+//------------------------------------------------------------------------------
+
+#endif // SBNOBJ_ICARUS_PMT_TRIGGER_DATA_WAVEFORMDISCRIMINATOR_H
@@ -7,6 +7,7 @@
  * 
  * * `icarus::trigger::TriggerGateData< TODO >`
  *   (and its associations with `raw::OpDetWaveform`)
+ * * `icarus::trigger::OpticalTriggerGateTable_t`
  * 
  * See also `sbnobj/ICARUS/PMT/Trigger/Data/classes_def.xml`.
  */
@@ -14,6 +15,7 @@
 // ICARUS libraries
 #include "sbnobj/ICARUS/PMT/Trigger/Data/OpticalTriggerGate.h"
 #include "sbnobj/ICARUS/PMT/Trigger/Data/TriggerGateData.h"
+#include "sbnobj/ICARUS/PMT/Trigger/Data/TriggerGateTable.h"
 
 // LArSoft libraries
 #include "lardataalg/DetectorInfo/DetectorTimingTypes.h"
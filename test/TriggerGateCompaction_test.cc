@@ -0,0 +1,121 @@
+/**
+ * @file   test/TriggerGateCompaction_test.cc
+ * @brief  Tests compaction and deduplication of trigger gates.
+ * @see    `sbnobj/ICARUS/PMT/Trigger/Data/TriggerGateData.h`,
+ *         `sbnobj/ICARUS/PMT/Trigger/Data/TriggerGateDeduplication.h`
+ *
+ * Gates with redundant statuses (changes of tick which leave the opening count
+ * unchanged) must answer all queries the same way before and after
+ * `compact()`, and they must be recognised as duplicates of the gates with the
+ * same levels but without those statuses.
+ */
+
+// library headers
+#include "sbnobj/ICARUS/PMT/Trigger/Data/OpticalTriggerGate.h"
+#include "sbnobj/ICARUS/PMT/Trigger/Data/TriggerGateDeduplication.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <cassert>
+
+
+//------------------------------------------------------------------------------
+using Gate_t = icarus::trigger::OpticalTriggerGateData_t;
+using Tick_t = Gate_t::ClockTick_t;
+
+
+//------------------------------------------------------------------------------
+/// Checks that `a` and `b` answer the same to all the queries in `[ start, end ]`.
+void checkSameQueries(Gate_t const& a, Gate_t const& b, Tick_t start, Tick_t end)
+{
+  for (Tick_t tick = start; tick <= end; ++tick) {
+    assert(a.openingCount(tick) == b.openingCount(tick));
+    for (Gate_t::OpeningCount_t minOpening: { 1U, 2U, 3U }) {
+      assert(a.findOpen(minOpening, tick) == b.findOpen(minOpening, tick));
+      assert(a.findClose(minOpening, tick) == b.findClose(minOpening, tick));
+      assert
+        (a.findOpen(minOpening, start, tick) == b.findOpen(minOpening, start, tick));
+      assert
+        (a.findClose(minOpening, start, tick) == b.findClose(minOpening, start, tick));
+    } // for opening
+  } // for ticks
+} // checkSameQueries()
+
+
+//------------------------------------------------------------------------------
+void compactionTest() {
+
+  /*
+   * The gate is open [ 10, 30 [ at level 1 and [ 15, 25 [ at level 2,
+   * with redundant statuses at ticks 20 and 40.
+   */
+  Gate_t gate{ 5 };
+  gate.openBetween(10, 20);
+  gate.openBetween(20, 30);
+  gate.openBetween(15, 25);
+  gate.setOpeningAt(40, 0U);
+
+  Gate_t compacted = gate;
+  compacted.compact();
+
+  // the redundant statuses are gone, the levels are not
+  assert(!(compacted.gateLevels() == gate.gateLevels()));
+  assert(compacted.channels() == gate.channels());
+  assert(compacted.gateLevels().sameLevels(gate.gateLevels()));
+
+  checkSameQueries(gate, compacted, 0, 50);
+
+  assert(compacted.findOpen() == 10);
+  assert(compacted.findOpen(2U) == 15);
+  assert(compacted.findClose(2U, 15) == 25);
+  assert(compacted.findClose(1U, 10) == 30);
+  assert(compacted.openingCount(20) == 2U);
+  assert(compacted.openingCount(27) == 1U);
+  assert(compacted.openingCount(45) == 0U);
+
+  // compacting again changes nothing
+  Gate_t compactedTwice = compacted;
+  compactedTwice.compact();
+  assert(compactedTwice == compacted);
+
+} // compactionTest()
+
+
+//------------------------------------------------------------------------------
+void deduplicationTest() {
+
+  // `redundant` and `plain` differ only in redundant statuses
+  Gate_t redundant{ 7 }, plain{ 7 }, otherChannel{ 8 }, otherLevels{ 7 };
+  redundant.openBetween(5, 10);
+  redundant.openBetween(10, 20);
+  plain.openBetween(5, 20);
+  otherChannel.openBetween(5, 20);
+  otherLevels.openBetween(5, 21);
+
+  assert(redundant.gateLevels().sameLevels(plain.gateLevels()));
+  assert(
+    redundant.gateLevels().fingerprint() == plain.gateLevels().fingerprint()
+    );
+  assert(!redundant.gateLevels().sameLevels(otherLevels.gateLevels()));
+
+  std::vector<Gate_t> gates{ redundant, plain, otherChannel, otherLevels };
+  assert((icarus::trigger::findUniqueGates(gates)
+    == std::vector<std::size_t>{ 0U, 2U, 3U }));
+
+  assert(icarus::trigger::removeDuplicateGates(gates) == 1U);
+  assert(gates.size() == 3U);
+  assert(gates[0].gateLevels().sameLevels(plain.gateLevels()));
+  assert(gates[1].channels() == otherChannel.channels());
+  assert(gates[2].gateLevels().sameLevels(otherLevels.gateLevels()));
+
+} // deduplicationTest()
+
+
+//------------------------------------------------------------------------------
+int main() {
+
+  compactionTest();
+  deduplicationTest();
+
+  return 0;
+} // main()